@@ -2,43 +2,57 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <time.h>
 #include <ctype.h>
 
-// === Define game board dimensions ===
-#define ROWS 6
-#define COLUMNS 6
-#define TOTAL_CARDS (ROWS * COLUMNS)
-#define MAX_SCORE ((TOTAL_CARDS / 2) + 1) // +1 for the extra star card
+#include "memory_game_engine.h"
 
-// === Global variables for game state ===
-int player1_score = 0;
-int player2_score = 0;
+// === Largest board the console can show: one letter per column, one letter per pair ===
+#define MAX_CONSOLE_COLUMNS 26
+#define MAX_CONSOLE_PAIRS 26
 
 // === Function to validate coordinates ===
-bool validate_coordinates(char col, int row)
+bool validate_coordinates(const memory_game *game, char col, int row)
 {
-    return (col >= 'A' && col <= 'F') && (row >= 0 && row < ROWS);
+    return (col >= 'A' && col < 'A' + game->columns) && (row >= 0 && row < game->rows);
+}
+
+// === Function to print the line between two board rows ===
+void display_separator(const memory_game *game)
+{
+    printf("   +");
+    for (int j = 0; j < game->columns; j++)
+    {
+        printf("---+");
+    }
+    printf("\n");
 }
 
 // === Function to display the game board ===
-void display_board(char board_value[ROWS][COLUMNS], char revealed_col1, int revealed_row1,
+void display_board(const memory_game *game, char revealed_col1, int revealed_row1,
                    char revealed_col2, int revealed_row2)
 {
-    printf("\n     A   B   C   D   E   F\n");
-    printf("   +---+---+---+---+---+---+\n");
+    printf("\n  ");
+    for (int j = 0; j < game->columns; j++)
+    {
+        printf("   %c", 'A' + j);
+    }
+    printf("\n");
+    display_separator(game);
 
-    for (int i = 0; i < ROWS; i++)
+    for (int i = 0; i < game->rows; i++)
     {
         printf("%2d |", i);
-        for (int j = 0; j < COLUMNS; j++)
+        for (int j = 0; j < game->columns; j++)
         {
+            char card = card_symbol(game_card(game, i * game->columns + j));
             if ((i == revealed_row1 && j == (revealed_col1 - 'A')) ||
                 (i == revealed_row2 && j == (revealed_col2 - 'A')))
             {
-                printf(" %c |", board_value[i][j]);
+                printf(" %c |", card);
             }
-            else if (board_value[i][j] == ' ')
+            else if (card == ' ')
             {
                 printf("   |");
             }
@@ -47,20 +61,22 @@ void display_board(char board_value[ROWS][COLUMNS], char revealed_col1, int reve
                 printf(" # |");
             }
         }
-        printf("\n   +---+---+---+---+---+---+\n");
+        printf("\n");
+        display_separator(game);
     }
 }
 
 // === Function to display scores ===
-void display_scores()
+void display_scores(const memory_game *game)
 {
-    printf("\n   Player 1 score: %d\n", player1_score);
-    printf("   Player 2 score: %d\n\n", player2_score);
+    printf("\n   Player 1 score: %d\n", game->scores[0]);
+    printf("   Player 2 score: %d\n\n", game->scores[1]);
 }
 
 // === Function to handle player's turn ===
-void handle_turn(int *score, bool *continue_turn, char board_value[ROWS][COLUMNS], int player_number)
+void handle_turn(memory_game *game)
 {
+    int player_number = game->current_player + 1;
     char col1, col2;
     int row1, row2;
     bool valid_input = false;
@@ -81,15 +97,16 @@ void handle_turn(int *score, bool *continue_turn, char board_value[ROWS][COLUMNS
 
         col1 = toupper(col1);
 
-        if (!validate_coordinates(col1, row1))
+        if (!validate_coordinates(game, col1, row1))
         {
-            printf("   Invalid coordinates! Please enter a letter A-F and number 0-5\n");
+            printf("   Invalid coordinates! Please enter a letter A-%c and number 0-%d\n",
+                   'A' + game->columns - 1, game->rows - 1);
             while (getchar() != '\n')
                 ;
             continue;
         }
 
-        if (board_value[row1][col1 - 'A'] == ' ')
+        if (!game_has_card(game, row1 * game->columns + (col1 - 'A')))
         {
             printf("   This cell is already empty! Please choose another\n");
             continue;
@@ -113,15 +130,16 @@ void handle_turn(int *score, bool *continue_turn, char board_value[ROWS][COLUMNS
 
         col2 = toupper(col2);
 
-        if (!validate_coordinates(col2, row2))
+        if (!validate_coordinates(game, col2, row2))
         {
-            printf("   Invalid coordinates! Please enter a letter A-F and number 0-5\n");
+            printf("   Invalid coordinates! Please enter a letter A-%c and number 0-%d\n",
+                   'A' + game->columns - 1, game->rows - 1);
             while (getchar() != '\n')
                 ;
             continue;
         }
 
-        if (board_value[row2][col2 - 'A'] == ' ')
+        if (!game_has_card(game, row2 * game->columns + (col2 - 'A')))
         {
             printf("   This cell is already empty! Please choose another\n");
             continue;
@@ -136,148 +154,102 @@ void handle_turn(int *score, bool *continue_turn, char board_value[ROWS][COLUMNS
         valid_input = true;
     } while (!valid_input);
 
-    // === Convert column letters to array indices and get selected card values ===
-    int col1_num = (col1 - 'A');
-    int col2_num = (col2 - 'A');
-    char first_value = board_value[row1][col1_num];
-    char second_value = board_value[row2][col2_num];
-
-    // === Display current game state ===
-    display_scores();
-    display_board(board_value, col1, row1, col2, row2);
-
-    // === Check for matches and update scores ===
-    *continue_turn = false;
+    // === Convert coordinates to cell indices and display the revealed cards ===
+    int cell1 = row1 * game->columns + (col1 - 'A');
+    int cell2 = row2 * game->columns + (col2 - 'A');
+    display_scores(game);
+    display_board(game, col1, row1, col2, row2);
 
     // Add delay to show cards
-    printf("\nRevealed cards: %c and %c\n", first_value, second_value);
+    printf("\nRevealed cards: %c and %c\n", card_symbol(game_card(game, cell1)), card_symbol(game_card(game, cell2)));
     printf("Press Enter to continue...");
     while (getchar() != '\n')
         ;
     getchar();
 
-    if ((first_value == '*') || (second_value == '*'))
+    // === Apply the game rules ===
+    turn_result result = game_play_turn(game, cell1, cell2);
+    if (result.outcome == TURN_STAR)
     {
-        board_value[row1][col1_num] = ' ';
-        board_value[row2][col2_num] = ' ';
-        *score += 2;
-        *continue_turn = true;
         printf("   Found a star! Extra turn granted!\n");
     }
-    else if ((toupper(first_value) == toupper(second_value)) &&
-             (first_value != ' ' && second_value != ' '))
+    else if (result.outcome == TURN_MATCH)
     {
-        board_value[row1][col1_num] = ' ';
-        board_value[row2][col2_num] = ' ';
-        (*score)++;
-        *continue_turn = true;
         printf("   Match found! Extra turn granted!\n");
     }
     else
     {
         printf("   No match! Next player's turn.\n");
     }
-
-    // === Check for end game condition and handle remaining star cards ===
-    if (player1_score + player2_score >= MAX_SCORE - 2)
-    {
-        for (int i = 0; i < ROWS; i++)
-        {
-            for (int j = 0; j < COLUMNS; j++)
-            {
-                if (board_value[i][j] == '*')
-                {
-                    (*score)++;
-                    board_value[i][j] = ' ';
-                }
-            }
-        }
-    }
 }
 
-// === Function to initialize the game board ===
-void initialize_board(char board_value[ROWS][COLUMNS])
+// === Main function ===
+int main(int argc, char *argv[])
 {
-    char all_board_value[TOTAL_CARDS] = {
-        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
-        'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
-        'Q', '*', '*', 'a', 'b', 'c', 'd', 'e',
-        'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
-        'n', 'o', 'p', 'q'};
-
-    // === Randomly distribute cards on the board ===
-    for (int i = 0; i < ROWS; i++)
+    // === Optional board size and star count: rows columns stars ===
+    game_config config = default_config();
+    if (argc > 1)
     {
-        for (int j = 0; j < COLUMNS; j++)
-        {
-            bool put_value = false;
-            while (!put_value)
-            {
-                int random_index = rand() % TOTAL_CARDS;
-                if (all_board_value[random_index] != '0')
-                {
-                    board_value[i][j] = all_board_value[random_index];
-                    all_board_value[random_index] = '0';
-                    put_value = true;
-                }
-            }
-        }
+        config.rows = atoi(argv[1]);
+    }
+    if (argc > 2)
+    {
+        config.columns = atoi(argv[2]);
+    }
+    if (argc > 3)
+    {
+        config.star_count = atoi(argv[3]);
     }
-}
-
-// === Main function ===
-int main(void)
-{
-    // === Initialize random number generator ===
-    srand(time(NULL));
 
-    // === Initialize game board ===
-    char board_value[ROWS][COLUMNS] = {0};
-    initialize_board(board_value);
+    // === Initialize game board with a time based seed ===
+    memory_game game;
+    if (!game_create(&game, config))
+    {
+        printf("Invalid board! Use %d-%d rows and columns and a star count that leaves an even number of cards\n",
+               MIN_BOARD_SIDE, MAX_BOARD_SIDE);
+        return 1;
+    }
+    if (game.columns > MAX_CONSOLE_COLUMNS || game.pair_count > MAX_CONSOLE_PAIRS)
+    {
+        printf("Board too large to display! Use the simulator for boards past %d columns or %d pairs\n",
+               MAX_CONSOLE_COLUMNS, MAX_CONSOLE_PAIRS);
+        game_destroy(&game);
+        return 1;
+    }
+    game_reset(&game, (uint64_t)time(NULL));
 
     // === Display initial game state ===
     printf("\n=== Memory Game ===\n");
     printf("Find matching pairs of letters. Stars (*) are special cards worth 2 points!\n\n");
-    display_scores();
-    display_board(board_value, 'X', -1, 'X', -1); // No revealed cards initially
+    display_scores(&game);
+    display_board(&game, 'X', -1, 'X', -1); // No revealed cards initially
 
     // === Main game loop ===
-    bool player1_turn = true;
-    while (player1_score + player2_score < MAX_SCORE)
+    while (!game_is_over(&game))
     {
-        if (player1_turn)
-        {
-            handle_turn(&player1_score, &player1_turn, board_value, 1);
-        }
-        else
-        {
-            handle_turn(&player2_score, &player1_turn, board_value, 2);
-        }
-
-        if (!player1_turn)
-        {
-            printf("\nPlayer 2's turn\n");
-        }
-        else
-        {
-            printf("\nPlayer 1's turn\n");
-        }
+        handle_turn(&game);
+        printf("\nPlayer %d's turn\n", game.current_player + 1);
     }
 
     // === Display final results ===
     printf("\n=== Game Over! ===\n");
     printf("Final scores:\n");
-    printf("   Player 1: %d\n", player1_score);
-    printf("   Player 2: %d\n\n", player2_score);
+    printf("   Player 1: %d\n", game.scores[0]);
+    printf("   Player 2: %d\n\n", game.scores[1]);
 
-    if (player1_score > player2_score)
+    if (game.scores[0] > game.scores[1])
     {
         printf("Player 1 wins!\n");
     }
-    else
+    else if (game.scores[1] > game.scores[0])
     {
         printf("Player 2 wins!\n");
     }
+    else
+    {
+        printf("It's a tie!\n"); // Possible when max_score is even
+    }
 
+    game_destroy(&game);
     return 0;
 }
\ No newline at end of file
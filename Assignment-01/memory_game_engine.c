@@ -0,0 +1,343 @@
+// === Include necessary header files ===
+#include <stdlib.h>
+#include <string.h>
+
+#include "memory_game_engine.h"
+
+// === Functions to read and write the packed card code of a cell ===
+static int get_code(const memory_game *game, int cell)
+{
+    uint64_t bit = (uint64_t)cell * game->card_bits;
+    int word = bit / 64;
+    int offset = bit % 64;
+    uint64_t value = game->cards[word] >> offset;
+    if (offset + game->card_bits > 64)
+    {
+        value |= game->cards[word + 1] << (64 - offset);
+    }
+    return (int)(value & (((uint64_t)1 << game->card_bits) - 1));
+}
+
+static void set_code(memory_game *game, int cell, int code)
+{
+    uint64_t bit = (uint64_t)cell * game->card_bits;
+    int word = bit / 64;
+    int offset = bit % 64;
+    uint64_t mask = ((uint64_t)1 << game->card_bits) - 1;
+    game->cards[word] = (game->cards[word] & ~(mask << offset)) | ((uint64_t)code << offset);
+    if (offset + game->card_bits > 64)
+    {
+        int low_bits = 64 - offset;
+        game->cards[word + 1] = (game->cards[word + 1] & ~(mask >> low_bits)) | ((uint64_t)code >> low_bits);
+    }
+}
+
+// === Functions for the sparse cell sets ===
+bool cell_set_create(cell_set *set, int capacity, int total_cards)
+{
+    set->cells = malloc(sizeof(int) * (capacity + 1));
+    set->position = malloc(sizeof(int) * total_cards);
+    set->count = 0;
+    return set->cells != NULL && set->position != NULL;
+}
+
+void cell_set_destroy(cell_set *set)
+{
+    free(set->cells);
+    free(set->position);
+    set->cells = NULL;
+    set->position = NULL;
+    set->count = 0;
+}
+
+void cell_set_add(cell_set *set, int cell)
+{
+    set->position[cell] = set->count;
+    set->cells[set->count++] = cell;
+}
+
+void cell_set_remove(cell_set *set, int cell)
+{
+    // Move the last cell into the gap so removal does not shift the array
+    int index = set->position[cell];
+    int last_cell = set->cells[--set->count];
+    set->cells[index] = last_cell;
+    set->position[last_cell] = index;
+    set->position[cell] = -1;
+}
+
+bool cell_set_contains(const cell_set *set, int cell)
+{
+    return set->position[cell] >= 0;
+}
+
+// === Function to turn any seed, including 0, into a random number state (splitmix64) ===
+uint64_t random_seed(uint64_t seed)
+{
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (z ^ (z >> 31)) | 1; // xorshift needs a non-zero state
+}
+
+// === Function to get the next random number (xorshift64*) ===
+uint64_t random_next(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+// === Function to get an unbiased random number in [0, bound) ===
+uint64_t random_below(uint64_t *state, uint64_t bound)
+{
+    // Values below the threshold would make some results more likely
+    uint64_t threshold = -bound % bound;
+    uint64_t value;
+    do
+    {
+        value = random_next(state);
+    } while (value < threshold);
+    return value % bound;
+}
+
+// === Function to get the classic 6x6 board with two stars ===
+game_config default_config(void)
+{
+    game_config config = {ROWS, COLUMNS, STARS};
+    return config;
+}
+
+// === Function to allocate a game for a board size, returns false if the size is not allowed ===
+bool game_create(memory_game *game, game_config config)
+{
+    memset(game, 0, sizeof(memory_game));
+    int total_cards = config.rows * config.columns;
+    if (config.rows < MIN_BOARD_SIDE || config.rows > MAX_BOARD_SIDE ||
+        config.columns < MIN_BOARD_SIDE || config.columns > MAX_BOARD_SIDE ||
+        config.star_count < 0 || config.star_count > total_cards - 2 ||
+        (total_cards - config.star_count) % 2 != 0)
+    {
+        return false;
+    }
+
+    game->rows = config.rows;
+    game->columns = config.columns;
+    game->total_cards = total_cards;
+    game->star_count = config.star_count;
+    game->pair_count = (total_cards - config.star_count) / 2;
+    game->max_score = game->pair_count + game->star_count;
+
+    // === Enough bits for the largest card code ===
+    game->card_bits = 1;
+    while (((uint64_t)1 << game->card_bits) <= (uint64_t)(2 * game->pair_count))
+    {
+        game->card_bits++;
+    }
+
+    // One spare word so a code spanning two words can always read the next one
+    int card_words = (int)(((uint64_t)total_cards * game->card_bits + 63) / 64) + 1;
+    game->cards = calloc(card_words, sizeof(uint64_t));
+    bool remaining_created = cell_set_create(&game->remaining, total_cards, total_cards);
+    bool stars_created = cell_set_create(&game->stars, config.star_count, total_cards);
+    if (game->cards == NULL || !remaining_created || !stars_created)
+    {
+        game_destroy(game);
+        return false;
+    }
+
+    game_reset(game, 0);
+    return true;
+}
+
+// === Function to deal a new shuffled board ===
+void game_reset(memory_game *game, uint64_t seed)
+{
+    game->rng_state = random_seed(seed);
+    game->scores[0] = 0;
+    game->scores[1] = 0;
+    game->current_player = 0;
+    game->turns_played = 0;
+
+    // === Generate the card set: the stars, then both cards of every pair ===
+    // The remaining cells array holds the codes while they are shuffled
+    int *codes = game->remaining.cells;
+    int count = 0;
+    for (int i = 0; i < game->star_count; i++)
+    {
+        codes[count++] = STAR_CODE;
+    }
+    for (int pair = 0; pair < game->pair_count; pair++)
+    {
+        codes[count++] = 1 + 2 * pair;
+        codes[count++] = 2 + 2 * pair;
+    }
+
+    // === Randomly distribute cards on the board (Fisher-Yates shuffle) ===
+    for (int i = game->total_cards - 1; i > 0; i--)
+    {
+        int j = (int)random_below(&game->rng_state, i + 1);
+        int temp = codes[i];
+        codes[i] = codes[j];
+        codes[j] = temp;
+    }
+
+    game->stars.count = 0;
+    for (int cell = 0; cell < game->total_cards; cell++)
+    {
+        set_code(game, cell, codes[cell]);
+        game->stars.position[cell] = -1;
+        if (codes[cell] == STAR_CODE)
+        {
+            cell_set_add(&game->stars, cell);
+        }
+    }
+
+    // === Every cell starts on the board ===
+    for (int cell = 0; cell < game->total_cards; cell++)
+    {
+        game->remaining.cells[cell] = cell;
+        game->remaining.position[cell] = cell;
+    }
+    game->remaining.count = game->total_cards;
+}
+
+// === Function to free the memory of a game ===
+void game_destroy(memory_game *game)
+{
+    free(game->cards);
+    cell_set_destroy(&game->remaining);
+    cell_set_destroy(&game->stars);
+    memset(game, 0, sizeof(memory_game));
+}
+
+// === Function to get the card code of a cell, NO_CARD when the cell is empty ===
+int game_card(const memory_game *game, int cell)
+{
+    if (!game_has_card(game, cell))
+    {
+        return NO_CARD;
+    }
+    return get_code(game, cell);
+}
+
+// === Function to convert a card code to the letter shown on the board ===
+char card_symbol(int code)
+{
+    if (code == NO_CARD)
+    {
+        return ' ';
+    }
+    if (code == STAR_CODE)
+    {
+        return STAR_CARD;
+    }
+
+    // Only the first 26 pairs have letters, larger boards are played by the simulator
+    int pair = CARD_PAIR(code);
+    if (pair >= 26)
+    {
+        return '?';
+    }
+    return (code % 2 == 1) ? 'A' + pair : 'a' + pair;
+}
+
+// === Function to check whether a cell still holds a card ===
+bool game_has_card(const memory_game *game, int cell)
+{
+    return cell >= 0 && cell < game->total_cards && cell_set_contains(&game->remaining, cell);
+}
+
+// === Function to count the cards still on the board ===
+int game_cards_left(const memory_game *game)
+{
+    return game->remaining.count;
+}
+
+// === Function to get a cell still on the board, index is 0 to game_cards_left() - 1 ===
+int game_remaining_cell(const memory_game *game, int index)
+{
+    return game->remaining.cells[index];
+}
+
+// === Function to take a card off the board ===
+static void remove_card(memory_game *game, int cell)
+{
+    cell_set_remove(&game->remaining, cell);
+    if (cell_set_contains(&game->stars, cell))
+    {
+        cell_set_remove(&game->stars, cell);
+    }
+}
+
+// === Function to play one turn: reveal two cells and apply the rules ===
+turn_result game_play_turn(memory_game *game, int first_cell, int second_cell)
+{
+    turn_result result = {TURN_INVALID, NO_CARD, NO_CARD, game->current_player, 0};
+    if (!game_has_card(game, first_cell) || !game_has_card(game, second_cell) || first_cell == second_cell)
+    {
+        return result;
+    }
+
+    result.first_card = get_code(game, first_cell);
+    result.second_card = get_code(game, second_cell);
+    int *score = &game->scores[game->current_player];
+
+    // === Check for matches and update scores ===
+    if (result.first_card == STAR_CODE || result.second_card == STAR_CODE)
+    {
+        remove_card(game, first_cell);
+        remove_card(game, second_cell);
+        *score += 2;
+        result.outcome = TURN_STAR;
+    }
+    else if (CARD_PAIR(result.first_card) == CARD_PAIR(result.second_card))
+    {
+        remove_card(game, first_cell);
+        remove_card(game, second_cell);
+        (*score)++;
+        result.outcome = TURN_MATCH;
+    }
+    else
+    {
+        result.outcome = TURN_NO_MATCH;
+    }
+
+    // === Check for end game condition and hand remaining star cards to this player ===
+    // Only the star set is visited, never the whole board
+    if (game->scores[0] + game->scores[1] >= game->max_score - game->star_count)
+    {
+        while (game->stars.count > 0)
+        {
+            remove_card(game, game->stars.cells[game->stars.count - 1]);
+            (*score)++;
+            result.swept_stars++;
+        }
+    }
+
+    // === Matches and stars grant an extra turn, otherwise the other player goes ===
+    if (result.outcome == TURN_NO_MATCH)
+    {
+        game->current_player = 1 - game->current_player;
+    }
+    game->turns_played++;
+    return result;
+}
+
+// === Function to hand the turn to the other player without revealing cards ===
+void game_pass_turn(memory_game *game)
+{
+    game->current_player = 1 - game->current_player;
+    game->turns_played++;
+}
+
+// === Function to check for the end of the game ===
+bool game_is_over(const memory_game *game)
+{
+    // A star taken with a letter leaves that letter's partner unmatched, so the
+    // board can run out of playable pairs before it is empty
+    return game->scores[0] + game->scores[1] >= game->max_score || game_cards_left(game) < 2;
+}
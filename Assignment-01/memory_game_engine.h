@@ -0,0 +1,99 @@
+#ifndef MEMORY_GAME_ENGINE_H
+#define MEMORY_GAME_ENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// === Default game board dimensions ===
+#define ROWS 6
+#define COLUMNS 6
+#define STARS 2
+#define MIN_BOARD_SIDE 4
+#define MAX_BOARD_SIDE 1000
+
+// === Card codes: 0 is the star, pair p is 1 + 2p (upper case) and 2 + 2p (lower case) ===
+#define STAR_CODE 0
+#define NO_CARD (-1)
+#define CARD_PAIR(code) (((code) - 1) / 2)
+#define STAR_CARD '*'
+
+typedef struct
+{
+    int rows;
+    int columns;
+    int star_count;
+} game_config;
+
+// === Set of cells with O(1) add, remove and lookup by position ===
+typedef struct
+{
+    int *cells;
+    int *position; // Index of a cell in cells, or -1 when not in the set
+    int count;
+} cell_set;
+
+// === Complete state of one game, no globals so many games can run at once ===
+typedef struct
+{
+    int rows;
+    int columns;
+    int total_cards;
+    int star_count;
+    int pair_count;
+    int max_score; // One per pair, one per star
+
+    int card_bits;   // Bits used by each packed card code
+    uint64_t *cards; // Card code of every cell, card_bits each, may span two words
+    cell_set remaining; // Cells still on the board
+    cell_set stars;     // Star cells still on the board
+
+    uint64_t rng_state; // Per game random number generator
+    int scores[2];
+    int current_player; // 0 for player 1, 1 for player 2
+    int turns_played;
+} memory_game;
+
+typedef enum
+{
+    TURN_INVALID,  // Cell out of range, already empty, or the same cell twice
+    TURN_NO_MATCH, // Turn passes to the other player
+    TURN_MATCH,    // +1 and an extra turn
+    TURN_STAR      // +2 and an extra turn
+} turn_outcome;
+
+typedef struct
+{
+    turn_outcome outcome;
+    int first_card;
+    int second_card;
+    int player;      // Player who made the turn (0 or 1)
+    int swept_stars; // Stars collected by the end game sweep after this turn
+} turn_result;
+
+// === Seeded random numbers, the state lives with its owner so nothing is shared ===
+uint64_t random_seed(uint64_t seed);
+uint64_t random_next(uint64_t *state);
+uint64_t random_below(uint64_t *state, uint64_t bound);
+
+// === Sparse cell set functions, capacity is the most cells the set holds at once ===
+bool cell_set_create(cell_set *set, int capacity, int total_cards);
+void cell_set_destroy(cell_set *set);
+void cell_set_add(cell_set *set, int cell);
+void cell_set_remove(cell_set *set, int cell);
+bool cell_set_contains(const cell_set *set, int cell);
+
+// === Engine functions ===
+game_config default_config(void);
+bool game_create(memory_game *game, game_config config);
+void game_reset(memory_game *game, uint64_t seed);
+void game_destroy(memory_game *game);
+int game_card(const memory_game *game, int cell);
+char card_symbol(int code);
+bool game_has_card(const memory_game *game, int cell);
+int game_cards_left(const memory_game *game);
+int game_remaining_cell(const memory_game *game, int index);
+turn_result game_play_turn(memory_game *game, int first_cell, int second_cell);
+void game_pass_turn(memory_game *game);
+bool game_is_over(const memory_game *game);
+
+#endif
@@ -0,0 +1,408 @@
+// === Include necessary header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "memory_game_players.h"
+
+// === Random player: picks any two cards still on the board ===
+static void *random_create(uint64_t seed)
+{
+    uint64_t *rng_state = malloc(sizeof(uint64_t));
+    *rng_state = random_seed(seed);
+    return rng_state;
+}
+
+static void random_new_game(void *state, const memory_game *game)
+{
+    (void)state;
+    (void)game;
+}
+
+// === Function to pick a random cell of a set other than excluded_cell, -1 if there is none ===
+static int random_cell_from(uint64_t *rng_state, const cell_set *set, int excluded_cell)
+{
+    if (excluded_cell >= 0 && cell_set_contains(set, excluded_cell))
+    {
+        // Draw from all but the last slot and swap in the last cell if the excluded one comes up
+        int last = set->count - 1;
+        if (last == 0)
+        {
+            return -1;
+        }
+        int cell = set->cells[random_below(rng_state, last)];
+        return cell == excluded_cell ? set->cells[last] : cell;
+    }
+    if (set->count == 0)
+    {
+        return -1;
+    }
+    return set->cells[random_below(rng_state, set->count)];
+}
+
+// === Picking from the remaining cells index never retries on empty cells ===
+static int random_choose_first(void *state, const memory_game *game)
+{
+    return random_cell_from(state, &game->remaining, -1);
+}
+
+static int random_choose_second(void *state, const memory_game *game, int first_cell, int first_card)
+{
+    (void)first_card;
+    return random_cell_from(state, &game->remaining, first_cell);
+}
+
+static void random_observe(void *state, const memory_game *game, int cell, int card)
+{
+    (void)state;
+    (void)game;
+    (void)cell;
+    (void)card;
+}
+
+// === Memory players: remember where every revealed card code was seen ===
+// Perfect players never forget. Bounded players hold at most BOUNDED_CAPACITY
+// cards, and the chance to recall a card drops by BOUNDED_DECAY for every card
+// seen after it. Every lookup is an array index, so each move is O(1).
+#define BOUNDED_CAPACITY 12
+#define BOUNDED_DECAY 0.9
+
+typedef struct
+{
+    uint64_t rng_state;
+    int capacity;          // 0 for unlimited memory
+    double *recall_chance; // Chance to recall a card by how many cards were seen after it
+
+    int total_cards;     // Size the arrays below were allocated for
+    int *cell_of_code;   // Cell where each card code was seen, -1 when unknown
+    long *seen_at;       // Observation number when each card code was seen
+    char *pair_queued;   // Pair is already waiting in ready_pairs
+    int *ready_pairs;    // Pairs with both cards seen
+    int ready_count;
+    int *star_cells;     // Star cells seen
+    long *star_seen_at;  // Observation number when each star was seen
+    int star_seen_count;
+    cell_set unseen;     // Cells never revealed
+    long observations;
+    int planned_second;  // Partner cell when the first card came from a known pair
+} memory_player;
+
+static void *memory_create(uint64_t seed, int capacity, double decay)
+{
+    memory_player *player = calloc(1, sizeof(memory_player));
+    player->rng_state = random_seed(seed);
+    player->capacity = capacity;
+    if (capacity > 0)
+    {
+        player->recall_chance = malloc(sizeof(double) * capacity);
+        double chance = 1.0;
+        for (int age = 0; age < capacity; age++)
+        {
+            player->recall_chance[age] = chance;
+            chance *= decay;
+        }
+    }
+    return player;
+}
+
+static void *perfect_create(uint64_t seed)
+{
+    return memory_create(seed, 0, 1.0);
+}
+
+static void *bounded_create(uint64_t seed)
+{
+    return memory_create(seed, BOUNDED_CAPACITY, BOUNDED_DECAY);
+}
+
+static void memory_free_arrays(memory_player *player)
+{
+    free(player->cell_of_code);
+    free(player->seen_at);
+    free(player->pair_queued);
+    free(player->ready_pairs);
+    free(player->star_cells);
+    free(player->star_seen_at);
+    cell_set_destroy(&player->unseen);
+}
+
+static void memory_destroy(void *state)
+{
+    memory_player *player = state;
+    memory_free_arrays(player);
+    free(player->recall_chance);
+    free(player);
+}
+
+static void memory_new_game(void *state, const memory_game *game)
+{
+    memory_player *player = state;
+    int codes = 2 * game->pair_count + 1;
+
+    // Arrays are kept between games and only grow for a larger board
+    if (game->total_cards > player->total_cards)
+    {
+        memory_free_arrays(player);
+        int size = game->total_cards + 1;
+        player->total_cards = game->total_cards;
+        player->cell_of_code = malloc(sizeof(int) * size);
+        player->seen_at = malloc(sizeof(long) * size);
+        player->pair_queued = malloc(size);
+        player->ready_pairs = malloc(sizeof(int) * size);
+        player->star_cells = malloc(sizeof(int) * size);
+        player->star_seen_at = malloc(sizeof(long) * size);
+        cell_set_create(&player->unseen, size, size);
+    }
+
+    for (int code = 0; code < codes; code++)
+    {
+        player->cell_of_code[code] = -1;
+    }
+    memset(player->pair_queued, 0, game->pair_count);
+    player->ready_count = 0;
+    player->star_seen_count = 0;
+    player->observations = 0;
+    player->planned_second = -1;
+
+    player->unseen.count = 0;
+    for (int cell = 0; cell < game->total_cards; cell++)
+    {
+        cell_set_add(&player->unseen, cell);
+    }
+}
+
+// === Function to check whether a memory is still recalled ===
+static bool memory_recalls(memory_player *player, long seen_at)
+{
+    if (player->capacity == 0)
+    {
+        return true;
+    }
+    long age = player->observations - seen_at;
+    if (age >= player->capacity)
+    {
+        return false;
+    }
+    double roll = (random_next(&player->rng_state) >> 11) * 0x1.0p-53;
+    return roll < player->recall_chance[age];
+}
+
+// === Function to get the cell of a remembered card code still on the board, -1 if forgotten ===
+static int memory_recall(memory_player *player, const memory_game *game, int code)
+{
+    int cell = player->cell_of_code[code];
+    if (cell < 0 || !game_has_card(game, cell) || !memory_recalls(player, player->seen_at[code]))
+    {
+        return -1;
+    }
+    return cell;
+}
+
+// === Function to get a remembered star still on the board, -1 if there is none ===
+static int memory_recall_star(memory_player *player, const memory_game *game, int excluded_cell)
+{
+    // Newest first; the excluded cell is still on the board, so it is skipped but kept
+    for (int index = player->star_seen_count - 1; index >= 0; index--)
+    {
+        int cell = player->star_cells[index];
+        if (cell == excluded_cell)
+        {
+            continue;
+        }
+        if (game_has_card(game, cell) && memory_recalls(player, player->star_seen_at[index]))
+        {
+            return cell;
+        }
+
+        // Taken or forgotten, newer entries above it move down
+        int newer = player->star_seen_count - 1 - index;
+        memmove(&player->star_cells[index], &player->star_cells[index + 1], sizeof(int) * newer);
+        memmove(&player->star_seen_at[index], &player->star_seen_at[index + 1], sizeof(long) * newer);
+        player->star_seen_count--;
+    }
+    return -1;
+}
+
+// === Function to pick a cell to learn from: never seen when memory is perfect, else any ===
+static int memory_explore(memory_player *player, const memory_game *game, int excluded_cell)
+{
+    if (player->capacity == 0)
+    {
+        // Stars taken by the end game sweep leave the board without being revealed
+        int cell;
+        while ((cell = random_cell_from(&player->rng_state, &player->unseen, excluded_cell)) >= 0)
+        {
+            if (game_has_card(game, cell))
+            {
+                return cell;
+            }
+            cell_set_remove(&player->unseen, cell);
+        }
+    }
+    return random_cell_from(&player->rng_state, &game->remaining, excluded_cell);
+}
+
+static int memory_choose_first(void *state, const memory_game *game)
+{
+    memory_player *player = state;
+
+    // === Play a known pair ===
+    while (player->ready_count > 0)
+    {
+        int pair = player->ready_pairs[--player->ready_count];
+        player->pair_queued[pair] = 0;
+        int first_cell = memory_recall(player, game, 1 + 2 * pair);
+        int second_cell = memory_recall(player, game, 2 + 2 * pair);
+        if (first_cell >= 0 && second_cell >= 0)
+        {
+            player->planned_second = second_cell;
+            return first_cell;
+        }
+    }
+
+    // === A known star is worth 2 with any card ===
+    int star_cell = memory_recall_star(player, game, -1);
+    if (star_cell >= 0)
+    {
+        return star_cell;
+    }
+    return memory_explore(player, game, -1);
+}
+
+static int memory_choose_second(void *state, const memory_game *game, int first_cell, int first_card)
+{
+    memory_player *player = state;
+    int planned_second = player->planned_second;
+    player->planned_second = -1;
+    if (planned_second >= 0 && planned_second != first_cell && game_has_card(game, planned_second))
+    {
+        return planned_second;
+    }
+
+    if (first_card != STAR_CODE)
+    {
+        // === Partner of the first card, or a star which scores with anything ===
+        int partner_code = (first_card % 2 == 1) ? first_card + 1 : first_card - 1;
+        int partner_cell = memory_recall(player, game, partner_code);
+        if (partner_cell >= 0 && partner_cell != first_cell)
+        {
+            return partner_cell;
+        }
+        int star_cell = memory_recall_star(player, game, first_cell);
+        if (star_cell >= 0)
+        {
+            return star_cell;
+        }
+    }
+    return memory_explore(player, game, first_cell);
+}
+
+static void memory_observe(void *state, const memory_game *game, int cell, int card)
+{
+    memory_player *player = state;
+    player->observations++;
+    bool first_sight = cell_set_contains(&player->unseen, cell);
+    if (first_sight)
+    {
+        cell_set_remove(&player->unseen, cell);
+    }
+
+    if (card == STAR_CODE)
+    {
+        if (first_sight)
+        {
+            player->star_cells[player->star_seen_count] = cell;
+            player->star_seen_at[player->star_seen_count++] = player->observations;
+        }
+        return;
+    }
+
+    player->cell_of_code[card] = cell;
+    player->seen_at[card] = player->observations;
+
+    // === Queue the pair once both of its cards are remembered ===
+    int pair = CARD_PAIR(card);
+    int partner_code = (card % 2 == 1) ? card + 1 : card - 1;
+    if (!player->pair_queued[pair] && memory_recall(player, game, partner_code) >= 0 &&
+        player->cell_of_code[partner_code] != cell)
+    {
+        player->pair_queued[pair] = 1;
+        player->ready_pairs[player->ready_count++] = pair;
+    }
+}
+
+// === Table of all policies ===
+static const player_policy policies[] = {
+    {"random", random_create, random_new_game, random_choose_first, random_choose_second, random_observe, free},
+    {"perfect", perfect_create, memory_new_game, memory_choose_first, memory_choose_second, memory_observe, memory_destroy},
+    {"bounded", bounded_create, memory_new_game, memory_choose_first, memory_choose_second, memory_observe, memory_destroy},
+};
+#define POLICY_COUNT ((int)(sizeof(policies) / sizeof(policies[0])))
+
+// === Function to find a policy by name ===
+const player_policy *find_policy(const char *name)
+{
+    for (int i = 0; i < POLICY_COUNT; i++)
+    {
+        if (strcmp(policies[i].name, name) == 0)
+        {
+            return &policies[i];
+        }
+    }
+    return NULL;
+}
+
+// === Functions to walk the table of policies ===
+int policy_count(void)
+{
+    return POLICY_COUNT;
+}
+
+const player_policy *policy_at(int index)
+{
+    return &policies[index];
+}
+
+// === Function to print the names of all policies ===
+void list_policies(void)
+{
+    for (int i = 0; i < POLICY_COUNT; i++)
+    {
+        printf("   %s\n", policies[i].name);
+    }
+}
+
+// === Function to play one game without any input or output ===
+void play_game(memory_game *game, const player_policy *policy1, void *state1,
+               const player_policy *policy2, void *state2, uint64_t seed)
+{
+    const player_policy *policy[2] = {policy1, policy2};
+    void *state[2] = {state1, state2};
+
+    game_reset(game, seed);
+    policy1->new_game(state1, game);
+    policy2->new_game(state2, game);
+
+    while (!game_is_over(game))
+    {
+        int player = game->current_player;
+        int first_cell = policy[player]->choose_first(state[player], game);
+        int first_card = game_card(game, first_cell);
+        int second_cell = policy[player]->choose_second(state[player], game, first_cell, first_card);
+        int second_card = game_card(game, second_cell);
+
+        // Both players see the revealed cards before they are removed
+        for (int p = 0; p < 2; p++)
+        {
+            policy[p]->observe(state[p], game, first_cell, first_card);
+            policy[p]->observe(state[p], game, second_cell, second_card);
+        }
+
+        if (game_play_turn(game, first_cell, second_cell).outcome == TURN_INVALID)
+        {
+            fprintf(stderr, "Policy %s made an invalid move\n", policy[player]->name);
+            exit(1);
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef MEMORY_GAME_PLAYERS_H
+#define MEMORY_GAME_PLAYERS_H
+
+#include "memory_game_engine.h"
+
+// === A computer player: picks cells and learns from every revealed card ===
+// Policies must only learn cards through choose_second and observe, never by
+// reading hidden cells of the game directly.
+typedef struct
+{
+    const char *name;
+    void *(*create)(uint64_t seed);
+    void (*new_game)(void *state, const memory_game *game);
+    int (*choose_first)(void *state, const memory_game *game);
+    int (*choose_second)(void *state, const memory_game *game, int first_cell, int first_card);
+    void (*observe)(void *state, const memory_game *game, int cell, int card); // Called for both players' reveals
+    void (*destroy)(void *state);
+} player_policy;
+
+// === Functions to look up the available policies ===
+const player_policy *find_policy(const char *name);
+int policy_count(void);
+const player_policy *policy_at(int index);
+void list_policies(void);
+
+// === Function to play one game between two policies on an allocated game ===
+void play_game(memory_game *game, const player_policy *policy1, void *state1,
+               const player_policy *policy2, void *state2, uint64_t seed);
+
+#endif
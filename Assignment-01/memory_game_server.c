@@ -0,0 +1,697 @@
+// === Include necessary header files ===
+#define _GNU_SOURCE // accept4
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#include "memory_game_engine.h"
+
+// === Server settings ===
+#define DEFAULT_PORT 5050
+#define MAX_SESSIONS 4096
+#define MAX_CONNECTIONS (2 * MAX_SESSIONS + 1)
+#define MAX_EVENTS 256
+#define INPUT_BUFFER 256
+#define OUTPUT_BUFFER 4096
+#define TURN_TIMEOUT_SECONDS 30
+#define WHEEL_SLOTS 64 // Timer wheel with one slot per second
+#define TICK_MS 1000
+
+/* Protocol, one line per message, cells are numbered row * columns + column:
+ *   client: FLIP <cell> <cell>     reveal two cells on your turn
+ *   client: PLAY                   join the next game after one ends
+ *   server: WAIT                   waiting for an opponent
+ *   server: START <rows> <columns> <player>
+ *   server: SHOW <cell> <card> <cell> <card>   card 0 is a star, 1 + 2p and 2 + 2p are pair p
+ *   server: GONE <cell> ...        cells taken off the board
+ *   server: SCORE <player 1> <player 2>
+ *   server: TURN <player>
+ *   server: TIMEOUT <player>
+ *   server: OVER <player 1> <player 2> <winner or 0 for a tie> [forfeit]
+ *   server: ERR <message>
+ * Only what changed is sent, clients keep their own copy of the board.
+ */
+
+struct game_session;
+
+// === Node of the timer wheel, one per session ===
+typedef struct timer_node
+{
+    struct timer_node *next;
+    struct timer_node *prev;
+    int rounds; // Full turns of the wheel left before the timer fires
+    struct game_session *session;
+} timer_node;
+
+// === One client socket ===
+typedef struct connection
+{
+    int fd;
+    struct game_session *session;
+    int player; // 0 or 1 inside the session
+    char input[INPUT_BUFFER];
+    int input_length;
+    char output[OUTPUT_BUFFER];
+    int output_length;
+    bool want_write; // EPOLLOUT is registered because output is pending
+    bool dropped;    // Shut down, closed when epoll reports the hang up
+    bool queued;     // On the list of connections with output to flush
+    struct connection *next_queued;
+    struct connection *next_free;
+} connection;
+
+// === One two-player game ===
+typedef struct game_session
+{
+    memory_game game;
+    bool game_created; // Boards are allocated on first use and kept in the pool
+    connection *players[2];
+    timer_node timer;
+    struct game_session *next_free;
+} game_session;
+
+// === Whole server state ===
+typedef struct
+{
+    int epoll_fd;
+    int listen_fd;
+    game_config config;
+    uint64_t seed_state;
+
+    connection connections[MAX_CONNECTIONS];
+    connection *free_connections;
+    game_session sessions[MAX_SESSIONS];
+    game_session *free_sessions;
+    connection *waiting; // Player waiting for an opponent
+    connection *queued;  // Connections with new output, flushed once per event
+    int *swept_cells;    // Stars on the board before a turn that may end in a sweep
+
+    timer_node wheel[WHEEL_SLOTS]; // List heads
+    int current_slot;
+    long long next_tick_ms;
+} game_server;
+
+static game_server server;
+
+// === Function to get a monotonic time in milliseconds ===
+static long long now_ms(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+// === Timer wheel functions ===
+static void timer_cancel(timer_node *node)
+{
+    if (node->next != NULL)
+    {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        node->next = NULL;
+        node->prev = NULL;
+    }
+}
+
+static void timer_arm(timer_node *node, int seconds)
+{
+    timer_cancel(node);
+    int slot = (server.current_slot + seconds) % WHEEL_SLOTS;
+    node->rounds = (seconds - 1) / WHEEL_SLOTS;
+    timer_node *head = &server.wheel[slot];
+    node->next = head->next;
+    node->prev = head;
+    head->next->prev = node;
+    head->next = node;
+}
+
+// === Output functions: lines are queued and written with one write() per connection after each event,
+// or earlier when the buffer fills up ===
+static void drop_connection(connection *conn)
+{
+    // Closing here would free sessions still in use by the caller, so only shut the
+    // socket down and let the event loop close it
+    conn->dropped = true;
+    conn->output_length = 0;
+    shutdown(conn->fd, SHUT_RDWR);
+}
+
+static void flush_output(connection *conn)
+{
+    int written = 0;
+    while (written < conn->output_length)
+    {
+        ssize_t result = write(conn->fd, conn->output + written, conn->output_length - written);
+        if (result < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+            drop_connection(conn);
+            return;
+        }
+        written += result;
+    }
+    memmove(conn->output, conn->output + written, conn->output_length - written);
+    conn->output_length -= written;
+
+    // Only ask for writable events while output is pending, and only tell epoll when that changes
+    bool want_write = conn->output_length > 0;
+    if (want_write != conn->want_write)
+    {
+        struct epoll_event event = {0};
+        event.events = EPOLLIN | (want_write ? EPOLLOUT : 0);
+        event.data.ptr = conn;
+        epoll_ctl(server.epoll_fd, EPOLL_CTL_MOD, conn->fd, &event);
+        conn->want_write = want_write;
+    }
+}
+
+static void flush_queued(void)
+{
+    while (server.queued != NULL)
+    {
+        connection *conn = server.queued;
+        server.queued = conn->next_queued;
+        conn->queued = false;
+        // A connection waiting for EPOLLOUT is flushed when the socket has room
+        if (conn->fd >= 0 && !conn->dropped && !conn->want_write)
+        {
+            flush_output(conn);
+        }
+    }
+}
+
+static void send_line(connection *conn, const char *format, ...)
+{
+    if (conn == NULL || conn->dropped)
+    {
+        return;
+    }
+
+    char line[OUTPUT_BUFFER];
+    va_list arguments;
+    va_start(arguments, format);
+    int length = vsnprintf(line, sizeof(line), format, arguments);
+    va_end(arguments);
+    if (length < 0 || length >= (int)sizeof(line))
+    {
+        return;
+    }
+
+    // A long sweep can fill the buffer within one event, so it is written out early while the socket has room
+    if (conn->output_length + length > OUTPUT_BUFFER && !conn->want_write)
+    {
+        flush_output(conn);
+        if (conn->dropped)
+        {
+            return;
+        }
+    }
+    if (conn->output_length + length > OUTPUT_BUFFER)
+    {
+        // Still full while waiting for EPOLLOUT: a client that stops reading is dropped instead of buffering forever
+        fprintf(stderr, "Output buffer full, dropping client\n");
+        drop_connection(conn);
+        return;
+    }
+    memcpy(conn->output + conn->output_length, line, length);
+    conn->output_length += length;
+    if (!conn->queued)
+    {
+        conn->queued = true;
+        conn->next_queued = server.queued;
+        server.queued = conn;
+    }
+}
+
+static void send_both(game_session *session, const char *line)
+{
+    send_line(session->players[0], "%s", line);
+    send_line(session->players[1], "%s", line);
+}
+
+// === Session functions ===
+// forfeiting_player is 0 or 1 when that player left the game, -1 when the game ended normally
+static void end_session(game_session *session, int forfeiting_player)
+{
+    memory_game *game = &session->game;
+    int winner = game->scores[0] > game->scores[1] ? 1 : (game->scores[1] > game->scores[0] ? 2 : 0);
+    if (forfeiting_player >= 0)
+    {
+        winner = 2 - forfeiting_player; // The other player wins by forfeit
+    }
+    char line[64];
+    snprintf(line, sizeof(line), "OVER %d %d %d%s\n", game->scores[0], game->scores[1], winner,
+             forfeiting_player >= 0 ? " forfeit" : "");
+
+    timer_cancel(&session->timer);
+    for (int p = 0; p < 2; p++)
+    {
+        connection *conn = session->players[p];
+        session->players[p] = NULL;
+        if (conn != NULL)
+        {
+            conn->session = NULL;
+            send_line(conn, "%s", line);
+        }
+    }
+
+    session->next_free = server.free_sessions;
+    server.free_sessions = session;
+}
+
+static void start_session(connection *first, connection *second)
+{
+    game_session *session = server.free_sessions;
+    if (session == NULL)
+    {
+        send_line(first, "ERR server full\n");
+        send_line(second, "ERR server full\n");
+        return;
+    }
+    server.free_sessions = session->next_free;
+
+    if (!session->game_created)
+    {
+        if (!game_create(&session->game, server.config))
+        {
+            // Out of memory for another board, the players can send PLAY to try again
+            session->next_free = server.free_sessions;
+            server.free_sessions = session;
+            send_line(first, "ERR out of memory\n");
+            send_line(second, "ERR out of memory\n");
+            return;
+        }
+        session->game_created = true;
+    }
+    game_reset(&session->game, random_next(&server.seed_state));
+
+    session->players[0] = first;
+    session->players[1] = second;
+    first->session = session;
+    first->player = 0;
+    second->session = session;
+    second->player = 1;
+
+    send_line(first, "START %d %d 1\n", session->game.rows, session->game.columns);
+    send_line(second, "START %d %d 2\n", session->game.rows, session->game.columns);
+    send_both(session, "TURN 1\n");
+    timer_arm(&session->timer, TURN_TIMEOUT_SECONDS);
+}
+
+static void join_lobby(connection *conn)
+{
+    if (server.waiting == NULL)
+    {
+        server.waiting = conn;
+        send_line(conn, "WAIT\n");
+        return;
+    }
+    connection *opponent = server.waiting;
+    server.waiting = NULL;
+    start_session(opponent, conn);
+}
+
+// === Function to fire all timers of the next wheel slot ===
+static void advance_wheel(void)
+{
+    server.current_slot = (server.current_slot + 1) % WHEEL_SLOTS;
+    timer_node *head = &server.wheel[server.current_slot];
+
+    // Detach the slot first, expired timers are re-armed into the wheel
+    timer_node *node = head->next;
+    head->next = head;
+    head->prev = head;
+    while (node != head)
+    {
+        timer_node *next = node->next;
+        node->next = NULL;
+        node->prev = NULL;
+        if (node->rounds > 0)
+        {
+            int rounds = node->rounds - 1;
+            timer_arm(node, WHEEL_SLOTS);
+            node->rounds = rounds;
+        }
+        else
+        {
+            // === Turn timeout: the other player moves ===
+            game_session *session = node->session;
+            char line[32];
+            snprintf(line, sizeof(line), "TIMEOUT %d\n", session->game.current_player + 1);
+            send_both(session, line);
+            game_pass_turn(&session->game);
+            snprintf(line, sizeof(line), "TURN %d\n", session->game.current_player + 1);
+            send_both(session, line);
+            timer_arm(node, TURN_TIMEOUT_SECONDS);
+        }
+        node = next;
+    }
+}
+
+// === Function to handle one FLIP command ===
+static void handle_flip(connection *conn, int first_cell, int second_cell)
+{
+    game_session *session = conn->session;
+    if (session == NULL)
+    {
+        send_line(conn, "ERR not in a game\n");
+        return;
+    }
+    memory_game *game = &session->game;
+    if (game->current_player != conn->player)
+    {
+        send_line(conn, "ERR not your turn\n");
+        return;
+    }
+
+    // A turn adds at most 2 points, so stars can only be swept when the total gets close
+    int swept_count = 0;
+    if (game->scores[0] + game->scores[1] + 2 >= game->max_score - game->star_count)
+    {
+        swept_count = game->stars.count;
+        memcpy(server.swept_cells, game->stars.cells, sizeof(int) * swept_count);
+    }
+
+    turn_result result = game_play_turn(game, first_cell, second_cell);
+    if (result.outcome == TURN_INVALID)
+    {
+        send_line(conn, "ERR invalid move\n");
+        return;
+    }
+
+    // === Send only the changes ===
+    char line[OUTPUT_BUFFER / 2];
+    snprintf(line, sizeof(line), "SHOW %d %d %d %d\n", first_cell, result.first_card, second_cell, result.second_card);
+    send_both(session, line);
+
+    if (result.outcome != TURN_NO_MATCH || result.swept_stars > 0)
+    {
+        int length = snprintf(line, sizeof(line), "GONE");
+        if (result.outcome != TURN_NO_MATCH)
+        {
+            length += snprintf(line + length, sizeof(line) - length, " %d %d", first_cell, second_cell);
+        }
+        for (int i = 0; i < swept_count; i++)
+        {
+            int cell = server.swept_cells[i];
+            if (cell == first_cell || cell == second_cell || game_has_card(game, cell))
+            {
+                continue;
+            }
+            // Long sweeps on big boards are split over several GONE lines
+            if (length > (int)sizeof(line) - 16)
+            {
+                snprintf(line + length, sizeof(line) - length, "\n");
+                send_both(session, line);
+                length = snprintf(line, sizeof(line), "GONE");
+            }
+            length += snprintf(line + length, sizeof(line) - length, " %d", cell);
+        }
+        snprintf(line + length, sizeof(line) - length, "\n");
+        send_both(session, line);
+    }
+
+    snprintf(line, sizeof(line), "SCORE %d %d\n", game->scores[0], game->scores[1]);
+    send_both(session, line);
+
+    if (game_is_over(game))
+    {
+        end_session(session, -1);
+        return;
+    }
+    snprintf(line, sizeof(line), "TURN %d\n", game->current_player + 1);
+    send_both(session, line);
+    timer_arm(&session->timer, TURN_TIMEOUT_SECONDS);
+}
+
+// === Function to handle one line from a client ===
+static void handle_line(connection *conn, char *line)
+{
+    int first_cell, second_cell;
+    if (sscanf(line, "FLIP %d %d", &first_cell, &second_cell) == 2)
+    {
+        handle_flip(conn, first_cell, second_cell);
+    }
+    else if (strncmp(line, "PLAY", 4) == 0)
+    {
+        if (conn->session == NULL && server.waiting != conn)
+        {
+            join_lobby(conn);
+        }
+    }
+    else
+    {
+        send_line(conn, "ERR unknown command\n");
+    }
+}
+
+// === Connection functions ===
+static void close_connection(connection *conn)
+{
+    if (conn->fd < 0)
+    {
+        return;
+    }
+    if (server.waiting == conn)
+    {
+        server.waiting = NULL;
+    }
+
+    // The opponent wins by forfeit
+    int fd = conn->fd;
+    conn->fd = -1;
+    if (conn->session != NULL)
+    {
+        game_session *session = conn->session;
+        session->players[conn->player] = NULL;
+        conn->session = NULL;
+        end_session(session, conn->player);
+    }
+
+    epoll_ctl(server.epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+    close(fd);
+    conn->next_free = server.free_connections;
+    server.free_connections = conn;
+}
+
+static void read_input(connection *conn)
+{
+    while (conn->fd >= 0)
+    {
+        ssize_t result = read(conn->fd, conn->input + conn->input_length, INPUT_BUFFER - conn->input_length);
+        if (result == 0 || (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+        {
+            close_connection(conn);
+            return;
+        }
+        if (result < 0)
+        {
+            return; // Nothing more to read
+        }
+        conn->input_length += result;
+
+        // === Handle every complete line ===
+        int start = 0;
+        for (int i = 0; i < conn->input_length && conn->fd >= 0; i++)
+        {
+            if (conn->input[i] == '\n')
+            {
+                conn->input[i] = 0;
+                handle_line(conn, conn->input + start);
+                start = i + 1;
+            }
+        }
+        if (conn->fd < 0)
+        {
+            return;
+        }
+        memmove(conn->input, conn->input + start, conn->input_length - start);
+        conn->input_length -= start;
+
+        if (conn->input_length == INPUT_BUFFER)
+        {
+            send_line(conn, "ERR line too long\n");
+            close_connection(conn);
+            return;
+        }
+    }
+}
+
+static void accept_connections(void)
+{
+    while (1)
+    {
+        int fd = accept4(server.listen_fd, NULL, NULL, SOCK_NONBLOCK);
+        if (fd < 0)
+        {
+            return; // EAGAIN when all pending connections are accepted
+        }
+
+        connection *conn = server.free_connections;
+        if (conn == NULL)
+        {
+            close(fd);
+            continue;
+        }
+        server.free_connections = conn->next_free;
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        conn->fd = fd;
+        conn->session = NULL;
+        conn->input_length = 0;
+        conn->output_length = 0;
+        conn->want_write = false;
+        conn->dropped = false;
+
+        struct epoll_event event = {0};
+        event.events = EPOLLIN;
+        event.data.ptr = conn;
+        epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, fd, &event);
+        join_lobby(conn);
+    }
+}
+
+// === Function to open the listening socket on localhost ===
+static int open_listener(int port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in address = {0};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// === Main function ===
+int main(int argc, char *argv[])
+{
+    int port = argc > 1 ? atoi(argv[1]) : DEFAULT_PORT;
+    server.config = default_config();
+    server.config.rows = argc > 2 ? atoi(argv[2]) : server.config.rows;
+    server.config.columns = argc > 3 ? atoi(argv[3]) : server.config.columns;
+    server.config.star_count = argc > 4 ? atoi(argv[4]) : server.config.star_count;
+
+    memory_game board_check;
+    if (!game_create(&board_check, server.config))
+    {
+        printf("Usage: %s [port] [rows] [columns] [stars]\n", argv[0]);
+        return 1;
+    }
+    game_destroy(&board_check);
+    server.swept_cells = malloc(sizeof(int) * (server.config.star_count + 1));
+
+    // === Allow one socket per connection ===
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < MAX_CONNECTIONS + 16)
+    {
+        limit.rlim_cur = limit.rlim_max < MAX_CONNECTIONS + 16 ? limit.rlim_max : MAX_CONNECTIONS + 16;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    // === Build the pools as free lists ===
+    for (int i = MAX_CONNECTIONS - 1; i >= 0; i--)
+    {
+        server.connections[i].fd = -1;
+        server.connections[i].next_free = server.free_connections;
+        server.free_connections = &server.connections[i];
+    }
+    for (int i = MAX_SESSIONS - 1; i >= 0; i--)
+    {
+        server.sessions[i].timer.session = &server.sessions[i];
+        server.sessions[i].next_free = server.free_sessions;
+        server.free_sessions = &server.sessions[i];
+    }
+    for (int i = 0; i < WHEEL_SLOTS; i++)
+    {
+        server.wheel[i].next = &server.wheel[i];
+        server.wheel[i].prev = &server.wheel[i];
+    }
+    server.seed_state = random_seed((uint64_t)time(NULL));
+
+    server.listen_fd = open_listener(port);
+    server.epoll_fd = epoll_create1(0);
+    if (server.listen_fd < 0 || server.epoll_fd < 0)
+    {
+        perror("Unable to start server");
+        return 1;
+    }
+    struct epoll_event listen_event = {0};
+    listen_event.events = EPOLLIN;
+    listen_event.data.ptr = NULL; // NULL marks the listening socket
+    epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.listen_fd, &listen_event);
+    printf("Memory game server listening on 127.0.0.1:%d\n", port);
+
+    // === Event loop ===
+    struct epoll_event events[MAX_EVENTS];
+    server.next_tick_ms = now_ms() + TICK_MS;
+    while (1)
+    {
+        long long wait_ms = server.next_tick_ms - now_ms();
+        int count = epoll_wait(server.epoll_fd, events, MAX_EVENTS, wait_ms > 0 ? (int)wait_ms : 0);
+        for (int i = 0; i < count; i++)
+        {
+            connection *conn = events[i].data.ptr;
+            if (conn == NULL)
+            {
+                accept_connections();
+            }
+            else if (events[i].events & (EPOLLERR | EPOLLHUP))
+            {
+                close_connection(conn);
+            }
+            else
+            {
+                if (events[i].events & EPOLLIN)
+                {
+                    read_input(conn);
+                }
+                if ((events[i].events & EPOLLOUT) && conn->fd >= 0 && !conn->dropped)
+                {
+                    flush_output(conn);
+                }
+            }
+
+            // Everything one event produced goes out in one write() per client
+            flush_queued();
+        }
+
+        // === Fire turn timeouts, catching up if the loop fell behind ===
+        long long now = now_ms();
+        while (now >= server.next_tick_ms)
+        {
+            advance_wheel();
+            server.next_tick_ms += TICK_MS;
+        }
+        flush_queued();
+    }
+    return 0;
+}
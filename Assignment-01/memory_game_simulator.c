@@ -0,0 +1,177 @@
+// === Include necessary header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "memory_game_players.h"
+
+// === Results gathered by one thread, merged after all threads finish ===
+typedef struct
+{
+    const player_policy *policy1;
+    const player_policy *policy2;
+    game_config config;
+    uint64_t seed;
+    long games;
+
+    long wins[2];
+    long ties;
+    long total_turns;
+    int score_buckets;
+    long *score_histogram[2];
+} simulation_batch;
+
+// === Function to get the number of score buckets, one for every score from 0 to max_score ===
+static int score_bucket_count(const memory_game *game)
+{
+    return game->max_score + 1;
+}
+
+// === Function run by every thread: plays its share of the games ===
+static void *run_batch(void *argument)
+{
+    simulation_batch *batch = argument;
+    void *state1 = batch->policy1->create(batch->seed ^ 0x1111);
+    void *state2 = batch->policy2->create(batch->seed ^ 0x2222);
+    uint64_t seed_state = random_seed(batch->seed);
+
+    // One board per thread, reshuffled for every game
+    memory_game game;
+    game_create(&game, batch->config);
+    batch->score_buckets = score_bucket_count(&game);
+    batch->score_histogram[0] = calloc(batch->score_buckets, sizeof(long));
+    batch->score_histogram[1] = calloc(batch->score_buckets, sizeof(long));
+
+    for (long i = 0; i < batch->games; i++)
+    {
+        play_game(&game, batch->policy1, state1, batch->policy2, state2, random_next(&seed_state));
+
+        if (game.scores[0] > game.scores[1])
+        {
+            batch->wins[0]++;
+        }
+        else if (game.scores[1] > game.scores[0])
+        {
+            batch->wins[1]++;
+        }
+        else
+        {
+            batch->ties++;
+        }
+        batch->total_turns += game.turns_played;
+        for (int p = 0; p < 2; p++)
+        {
+            batch->score_histogram[p][game.scores[p]]++;
+        }
+    }
+
+    game_destroy(&game);
+    batch->policy1->destroy(state1);
+    batch->policy2->destroy(state2);
+    return NULL;
+}
+
+// === Function to print how to use the simulator ===
+static void print_usage(const char *program)
+{
+    printf("Usage: %s [games] [threads] [seed] [player1 policy] [player2 policy] [rows] [columns] [stars]\n", program);
+    printf("Boards are %d-%d cells per side, default %dx%d with %d stars\n",
+           MIN_BOARD_SIDE, MAX_BOARD_SIDE, ROWS, COLUMNS, STARS);
+    printf("Policies:\n");
+    list_policies();
+}
+
+// === Main function ===
+int main(int argc, char *argv[])
+{
+    long games = argc > 1 ? atol(argv[1]) : 1000000;
+    int threads = argc > 2 ? atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    uint64_t seed = argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t)time(NULL);
+    const player_policy *policy1 = find_policy(argc > 4 ? argv[4] : "random");
+    const player_policy *policy2 = find_policy(argc > 5 ? argv[5] : "random");
+    game_config config = default_config();
+    config.rows = argc > 6 ? atoi(argv[6]) : config.rows;
+    config.columns = argc > 7 ? atoi(argv[7]) : config.columns;
+    config.star_count = argc > 8 ? atoi(argv[8]) : config.star_count;
+
+    // A throwaway game checks the board size before any thread starts
+    memory_game board_check;
+    if (games <= 0 || threads <= 0 || policy1 == NULL || policy2 == NULL || !game_create(&board_check, config))
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+    int score_buckets = score_bucket_count(&board_check);
+    game_destroy(&board_check);
+
+    // === Split the games across threads, each with its own seed ===
+    simulation_batch *batches = calloc(threads, sizeof(simulation_batch));
+    pthread_t *workers = malloc(sizeof(pthread_t) * threads);
+    uint64_t seed_state = random_seed(seed);
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int t = 0; t < threads; t++)
+    {
+        batches[t].policy1 = policy1;
+        batches[t].policy2 = policy2;
+        batches[t].config = config;
+        batches[t].seed = random_next(&seed_state);
+        batches[t].games = games / threads + (t < games % threads ? 1 : 0);
+        pthread_create(&workers[t], NULL, run_batch, &batches[t]);
+    }
+
+    // === Merge the results of all threads ===
+    simulation_batch total = {0};
+    total.score_histogram[0] = calloc(score_buckets, sizeof(long));
+    total.score_histogram[1] = calloc(score_buckets, sizeof(long));
+    for (int t = 0; t < threads; t++)
+    {
+        pthread_join(workers[t], NULL);
+        total.games += batches[t].games;
+        total.ties += batches[t].ties;
+        total.total_turns += batches[t].total_turns;
+        for (int p = 0; p < 2; p++)
+        {
+            total.wins[p] += batches[t].wins[p];
+            for (int s = 0; s < score_buckets; s++)
+            {
+                total.score_histogram[p][s] += batches[t].score_histogram[p][s];
+            }
+            free(batches[t].score_histogram[p]);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    // === Display the results ===
+    printf("\n=== Memory Game Simulation ===\n");
+    printf("   Board: %dx%d with %d stars\n", config.rows, config.columns, config.star_count);
+    printf("   Games: %ld on %d threads in %.2f s (%.0f games/min)\n",
+           total.games, threads, seconds, total.games / seconds * 60);
+    printf("   Average turns per game: %.2f\n\n", (double)total.total_turns / total.games);
+    printf("   Player 1 (%s) wins: %.2f%%\n", policy1->name, 100.0 * total.wins[0] / total.games);
+    printf("   Player 2 (%s) wins: %.2f%%\n", policy2->name, 100.0 * total.wins[1] / total.games);
+    printf("   Ties: %.2f%%\n\n", 100.0 * total.ties / total.games);
+
+    printf("   Score   Player 1   Player 2\n");
+    for (int s = 0; s < score_buckets; s++)
+    {
+        if (total.score_histogram[0][s] == 0 && total.score_histogram[1][s] == 0)
+        {
+            continue;
+        }
+        printf("   %5d   %7.3f%%   %7.3f%%\n", s,
+               100.0 * total.score_histogram[0][s] / total.games,
+               100.0 * total.score_histogram[1][s] / total.games);
+    }
+
+    free(total.score_histogram[0]);
+    free(total.score_histogram[1]);
+    free(batches);
+    free(workers);
+    return 0;
+}
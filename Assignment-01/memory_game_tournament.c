@@ -0,0 +1,317 @@
+// === Include necessary header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "memory_game_players.h"
+
+// === Tournament settings ===
+#define CHUNK_GAMES 1000     // Games handed to a thread at a time
+#define ELO_START 1500.0
+#define ELO_ITERATIONS 2000
+#define ELO_STEP 16.0
+
+// === Results of one pairing of two strategies, a always has the lower index ===
+typedef struct
+{
+    int a;
+    int b;
+    long games;
+    long wins_a;
+    long wins_b;
+    long ties;
+    long score_a;
+    long score_b;
+    long turns;
+} pairing_result;
+
+// === Shared tournament state, threads take chunks of games with an atomic counter ===
+typedef struct
+{
+    game_config config;
+    uint64_t seed;
+    int pairing_count;
+    long games_per_pairing;
+    long chunks_per_pairing;
+    atomic_long next_chunk;
+} tournament;
+
+typedef struct
+{
+    tournament *shared;
+    int thread_index;
+    pairing_result *results; // One entry per pairing, private to the thread
+} tournament_worker;
+
+// === Function run by every thread: plays chunks until none are left ===
+static void *run_worker(void *argument)
+{
+    tournament_worker *worker = argument;
+    tournament *shared = worker->shared;
+    long total_chunks = shared->chunks_per_pairing * shared->pairing_count;
+
+    // One board and one player state per strategy for this thread
+    memory_game game;
+    game_create(&game, shared->config);
+    int strategies = policy_count();
+    void **states = malloc(sizeof(void *) * strategies);
+    for (int i = 0; i < strategies; i++)
+    {
+        states[i] = policy_at(i)->create(shared->seed ^ ((uint64_t)i << 32) ^ (uint64_t)worker->thread_index);
+    }
+
+    long chunk;
+    while ((chunk = atomic_fetch_add(&shared->next_chunk, 1)) < total_chunks)
+    {
+        pairing_result *result = &worker->results[chunk / shared->chunks_per_pairing];
+        const player_policy *policy_a = policy_at(result->a);
+        const player_policy *policy_b = policy_at(result->b);
+        long first_game = (chunk % shared->chunks_per_pairing) * CHUNK_GAMES;
+        long last_game = first_game + CHUNK_GAMES;
+        if (last_game > shared->games_per_pairing)
+        {
+            last_game = shared->games_per_pairing;
+        }
+
+        // Boards depend only on the chunk, never on which thread plays it
+        uint64_t seed_state = random_seed(shared->seed + (uint64_t)chunk);
+        for (long i = first_game; i < last_game; i++)
+        {
+            // === Seats alternate so neither strategy always moves first ===
+            bool a_first = (i % 2 == 0);
+            int score_a, score_b;
+            if (a_first)
+            {
+                play_game(&game, policy_a, states[result->a], policy_b, states[result->b], random_next(&seed_state));
+                score_a = game.scores[0];
+                score_b = game.scores[1];
+            }
+            else
+            {
+                play_game(&game, policy_b, states[result->b], policy_a, states[result->a], random_next(&seed_state));
+                score_a = game.scores[1];
+                score_b = game.scores[0];
+            }
+
+            result->games++;
+            result->score_a += score_a;
+            result->score_b += score_b;
+            result->turns += game.turns_played;
+            if (score_a > score_b)
+            {
+                result->wins_a++;
+            }
+            else if (score_b > score_a)
+            {
+                result->wins_b++;
+            }
+            else
+            {
+                result->ties++;
+            }
+        }
+    }
+
+    for (int i = 0; i < strategies; i++)
+    {
+        policy_at(i)->destroy(states[i]);
+    }
+    free(states);
+    game_destroy(&game);
+    return NULL;
+}
+
+// === Function to fit Elo ratings to the results of all pairings ===
+static void compute_ratings(pairing_result *results, int pairing_count, double *ratings, int strategies)
+{
+    for (int i = 0; i < strategies; i++)
+    {
+        ratings[i] = ELO_START;
+    }
+
+    for (int iteration = 0; iteration < ELO_ITERATIONS; iteration++)
+    {
+        for (int p = 0; p < pairing_count; p++)
+        {
+            pairing_result *result = &results[p];
+            if (result->games == 0)
+            {
+                continue;
+            }
+
+            // One virtual draw keeps a perfect record from pushing ratings apart forever
+            double actual = (result->wins_a + 0.5 * result->ties + 0.5) / (result->games + 1);
+            double expected = 1.0 / (1.0 + pow(10.0, (ratings[result->b] - ratings[result->a]) / 400.0));
+            ratings[result->a] += ELO_STEP * (actual - expected);
+            ratings[result->b] -= ELO_STEP * (actual - expected);
+        }
+    }
+}
+
+// === Function to print how to use the tournament ===
+static void print_usage(const char *program)
+{
+    printf("Usage: %s [games per pairing] [threads] [seed] [rows] [columns] [stars]\n", program);
+    printf("Boards are %d-%d cells per side, default %dx%d with %d stars\n",
+           MIN_BOARD_SIDE, MAX_BOARD_SIDE, ROWS, COLUMNS, STARS);
+    printf("Strategies:\n");
+    list_policies();
+}
+
+// === Main function ===
+int main(int argc, char *argv[])
+{
+    tournament shared = {0};
+    shared.games_per_pairing = argc > 1 ? atol(argv[1]) : 100000;
+    int threads = argc > 2 ? atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    shared.seed = argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t)time(NULL);
+    shared.config = default_config();
+    shared.config.rows = argc > 4 ? atoi(argv[4]) : shared.config.rows;
+    shared.config.columns = argc > 5 ? atoi(argv[5]) : shared.config.columns;
+    shared.config.star_count = argc > 6 ? atoi(argv[6]) : shared.config.star_count;
+
+    memory_game board_check;
+    if (shared.games_per_pairing <= 0 || threads <= 0 || !game_create(&board_check, shared.config))
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+    game_destroy(&board_check);
+
+    // === Round robin: every strategy plays every other strategy ===
+    int strategies = policy_count();
+    shared.pairing_count = strategies * (strategies - 1) / 2;
+    shared.chunks_per_pairing = (shared.games_per_pairing + CHUNK_GAMES - 1) / CHUNK_GAMES;
+    atomic_init(&shared.next_chunk, 0);
+
+    tournament_worker *workers = malloc(sizeof(tournament_worker) * threads);
+    pthread_t *thread_ids = malloc(sizeof(pthread_t) * threads);
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int t = 0; t < threads; t++)
+    {
+        workers[t].shared = &shared;
+        workers[t].thread_index = t;
+        workers[t].results = calloc(shared.pairing_count, sizeof(pairing_result));
+        int p = 0;
+        for (int a = 0; a < strategies; a++)
+        {
+            for (int b = a + 1; b < strategies; b++, p++)
+            {
+                workers[t].results[p].a = a;
+                workers[t].results[p].b = b;
+            }
+        }
+        pthread_create(&thread_ids[t], NULL, run_worker, &workers[t]);
+    }
+
+    // === Merge the results of all threads ===
+    pairing_result *results = calloc(shared.pairing_count, sizeof(pairing_result));
+    long total_games = 0;
+    for (int t = 0; t < threads; t++)
+    {
+        pthread_join(thread_ids[t], NULL);
+        for (int p = 0; p < shared.pairing_count; p++)
+        {
+            pairing_result *from = &workers[t].results[p];
+            results[p].a = from->a;
+            results[p].b = from->b;
+            results[p].games += from->games;
+            results[p].wins_a += from->wins_a;
+            results[p].wins_b += from->wins_b;
+            results[p].ties += from->ties;
+            results[p].score_a += from->score_a;
+            results[p].score_b += from->score_b;
+            results[p].turns += from->turns;
+            total_games += from->games;
+        }
+        free(workers[t].results);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    // === Per strategy statistics ===
+    double *ratings = malloc(sizeof(double) * strategies);
+    compute_ratings(results, shared.pairing_count, ratings, strategies);
+
+    long *games = calloc(strategies, sizeof(long));
+    long *wins = calloc(strategies, sizeof(long));
+    long *ties = calloc(strategies, sizeof(long));
+    long *score = calloc(strategies, sizeof(long));
+    long *turns = calloc(strategies, sizeof(long));
+    for (int p = 0; p < shared.pairing_count; p++)
+    {
+        pairing_result *result = &results[p];
+        games[result->a] += result->games;
+        games[result->b] += result->games;
+        wins[result->a] += result->wins_a;
+        wins[result->b] += result->wins_b;
+        ties[result->a] += result->ties;
+        ties[result->b] += result->ties;
+        score[result->a] += result->score_a;
+        score[result->b] += result->score_b;
+        turns[result->a] += result->turns;
+        turns[result->b] += result->turns;
+    }
+
+    // === Display the results, best rating first ===
+    printf("\n=== Memory Game Tournament ===\n");
+    printf("   Board: %dx%d with %d stars\n", shared.config.rows, shared.config.columns, shared.config.star_count);
+    printf("   Games: %ld on %d threads in %.2f s (%.0f games/min)\n\n",
+           total_games, threads, seconds, total_games / seconds * 60);
+
+    int *order = malloc(sizeof(int) * strategies);
+    for (int i = 0; i < strategies; i++)
+    {
+        order[i] = i;
+    }
+    for (int i = 1; i < strategies; i++)
+    {
+        for (int j = i; j > 0 && ratings[order[j]] > ratings[order[j - 1]]; j--)
+        {
+            int temp = order[j];
+            order[j] = order[j - 1];
+            order[j - 1] = temp;
+        }
+    }
+
+    printf("   %-10s%8s%10s%8s%8s%8s%12s%12s\n", "Strategy", "Elo", "Games", "Win%", "Loss%", "Tie%", "Avg score", "Avg turns");
+    for (int k = 0; k < strategies; k++)
+    {
+        int i = order[k];
+        if (games[i] == 0)
+        {
+            continue;
+        }
+        long losses = games[i] - wins[i] - ties[i];
+        printf("   %-10s%8.0f%10ld%7.2f%%%7.2f%%%7.2f%%%12.2f%12.2f\n", policy_at(i)->name, ratings[i], games[i],
+               100.0 * wins[i] / games[i], 100.0 * losses / games[i], 100.0 * ties[i] / games[i],
+               (double)score[i] / games[i], (double)turns[i] / games[i]);
+    }
+
+    printf("\n   %-22s%10s%10s%8s\n", "Pairing", "Wins", "Wins", "Ties");
+    for (int p = 0; p < shared.pairing_count; p++)
+    {
+        char pairing[64];
+        snprintf(pairing, sizeof(pairing), "%s vs %s", policy_at(results[p].a)->name, policy_at(results[p].b)->name);
+        printf("   %-22s%10ld%10ld%8ld\n", pairing, results[p].wins_a, results[p].wins_b, results[p].ties);
+    }
+
+    free(order);
+    free(games);
+    free(wins);
+    free(ties);
+    free(score);
+    free(turns);
+    free(ratings);
+    free(results);
+    free(workers);
+    free(thread_ids);
+    return 0;
+}
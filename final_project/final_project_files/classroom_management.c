@@ -41,11 +41,15 @@ char **getAllRoomsList(char *data_file, int total_rooms)
     }
 
     // Read room numbers line by line and store in array
-    char line[6];
+    char line[32];
     int count = 0;
-    while (fgets(line, sizeof(line), file))
+    while (fgets(line, sizeof(line), file) && count < total_rooms)
     {
-        line[strcspn(line, "\n")] = 0; // Remove newline character
+        line[strcspn(line, "\r\n")] = 0; // Remove newline characters
+        if (line[0] == 0)
+        {
+            continue;
+        }
         room_array[count] = malloc(strlen(line) + 1);
         strcpy(room_array[count], line);
         count++;
@@ -266,15 +270,36 @@ char **checkCurrentFreeRooms(char *file_name, int total_rooms)
     return current_free_rooms;
 }
 
+//==============================================================================
+/**
+ * isSameTimeSlot - Compares a timetable time slot with a menu time slot
+ * @return: 1 if both name the same slot
+ *
+ * The timetable file writes the last slot as "3:00-5:00" while the menu
+ * prints "3:30-5:00".
+ */
+static int isSameTimeSlot(char *entry_time, char *selected_time_slot)
+{
+    if (strcmp(entry_time, "3:00-5:00") == 0)
+    {
+        entry_time = "3:30-5:00";
+    }
+    if (strcmp(selected_time_slot, "3:00-5:00") == 0)
+    {
+        selected_time_slot = "3:30-5:00";
+    }
+    return strcmp(entry_time, selected_time_slot) == 0;
+}
+
 //==============================================================================
 /**
  * checkFreeSlotsForDay - Checks which rooms are free for a specific day and time slot
  * @param file_name: Path to timetable file
  * @param rooms_file: Path to file containing room numbers
- * @return: Array of strings containing free room numbers
+ * @return: NULL terminated array of strings containing free room numbers
  *
  * Reads timetable and room files to determine which rooms are free for a
- * specific day and time slot. Returns NULL if no rooms are available.
+ * specific day and time slot. Returns NULL if a file cannot be opened.
  */
 char **checkFreeSlotsForDay(char *file_name, char *rooms_file, char *selected_day, char *selected_time_slot)
 {
@@ -293,50 +318,51 @@ char **checkFreeSlotsForDay(char *file_name, char *rooms_file, char *selected_da
         fclose(timetable_file);
         return NULL;
     }
+    fclose(all_rooms_file);
 
     // Read all available rooms
     char **available_rooms = getAllRoomsList(rooms_file, MAX_ROOMS);
 
-
     // Process timetable data
     char entry_day[15] = {0};
     char entry_time[15] = {0};
     char room_number[15] = {0};
     char timetable_entry[100];
-    char **occupied_rooms =  malloc(sizeof(char *) * MAX_ROOMS);
-    int occupied_count = 0;
 
-    // Find occupied rooms for selected day and time
+    // Remove every room that has a class on the selected day and time
     while (fgets(timetable_entry, sizeof(timetable_entry), timetable_file))
     {
-        sscanf(timetable_entry, "%*d,%*c,%[^,],%[^,],%*[^,],%*[^,],%s", entry_day, entry_time, room_number);
-        if((strcmp(selected_day, entry_day) == 0) && (strcmp(selected_time_slot, entry_time) == 0))
+        if (sscanf(timetable_entry, "%*d,%*c,%14[^,],%14[^,],%*[^,],%*[^,],%14s", entry_day, entry_time, room_number) != 3)
+        {
+            continue; // Header or malformed line
+        }
+        if ((strcmp(selected_day, entry_day) == 0) && isSameTimeSlot(entry_time, selected_time_slot))
         {
-            occupied_rooms[occupied_count] = malloc(strlen(room_number) + 1);
-            strcpy(occupied_rooms[occupied_count], room_number);
-            occupied_count++;
+            for (int i = 0; i < MAX_ROOMS; i++)
+            {
+                if (available_rooms[i] != NULL && strcmp(available_rooms[i], room_number) == 0)
+                {
+                    free(available_rooms[i]);
+                    available_rooms[i] = NULL;
+                }
+            }
         }
     }
+    fclose(timetable_file);
 
-    // Remove duplicates by setting them to NULL
+    // Pack the free rooms to the front so the array ends at the first NULL
+    char **free_rooms = malloc(sizeof(char *) * (MAX_ROOMS + 1));
+    int free_count = 0;
     for (int i = 0; i < MAX_ROOMS; i++)
     {
-        if (occupied_rooms[i] == NULL)
-            continue;
-
-        // Compare with all following elements
-        for (int j = i + 1; j < MAX_ROOMS; j++)
+        if (available_rooms[i] != NULL)
         {
-            if (occupied_rooms[j] != NULL && strcmp(occupied_rooms[i], occupied_rooms[j]) == 0)
-            {
-                occupied_rooms[j] = NULL; // Set duplicate to NULL
-            }
+            free_rooms[free_count++] = available_rooms[i];
         }
     }
-
-    fclose(timetable_file);
-    fclose(all_rooms_file);
-    return occupied_rooms;
+    free_rooms[free_count] = NULL;
+    free(available_rooms);
+    return free_rooms;
 }
 
 
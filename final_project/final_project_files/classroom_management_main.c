@@ -5,7 +5,11 @@
 #include <ctype.h>
 
 #define MAX_ROOMS 25
+#define MAX_FREE_SLOTS_SHOWN 20
 #include "classroom_management.h"
+#include "room_reservation.h"
+#include "free_time_finder.h"
+#include "timetable_history.h"
 
 
 
@@ -17,6 +21,22 @@ int main(void)
 {
     char *timetable_file = "CS_Department_Timetable.csv";
     char *rooms_file = "all_rooms.txt";
+    char *reservations_file = "room_reservations.log";
+    char *history_file = "timetable_history.dat";
+
+    // Reservations can be made from today until the end of the term window
+    char today[20];
+    time_t now = time(NULL);
+    strftime(today, sizeof(today), "%Y-%m-%d", localtime(&now));
+    ReservationBook *reservation_book = openReservationBook(timetable_file, rooms_file, today, reservations_file);
+
+    // Every run stores the timetable as a new version if it was edited since the last run
+    TimetableHistory *timetable_history = openTimetableHistory(rooms_file, history_file);
+    int current_version = -1;
+    if (timetable_history != NULL)
+    {
+        current_version = loadTimetableVersion(timetable_history, timetable_file);
+    }
 
     while (1)
     {
@@ -27,11 +47,16 @@ int main(void)
             printf("1. View your timetable.\n");
             printf("2. Check current-slot free rooms.\n");
             printf("3. Check free rooms for a specific day.\n");
-            printf("4. Exit the program.\n");
+            printf("4. Reserve a room.\n");
+            printf("5. Release a reserved room.\n");
+            printf("6. View your reservations.\n");
+            printf("7. Find common free time.\n");
+            printf("8. View an earlier timetable version.\n");
+            printf("9. Exit the program.\n");
 
             scanf("%d", &user_selection);
             while(getchar() != '\n'); // Clear input buffer
-        }while(user_selection != 1 && user_selection != 2 && user_selection != 3 && user_selection != 4);
+        }while(user_selection < 1 || user_selection > 9);
         
 
         // This condition will print the time-table for given semester and section
@@ -134,8 +159,262 @@ int main(void)
             }
             free(specific_day_free_rooms);
         }
-        else if (user_selection == 4)
+        // This condition will reserve or release a room for a date and time slot
+        else if (user_selection == 4 || user_selection == 5)
+        {
+            if (reservation_book == NULL)
+            {
+                printf("Reservations are not available.\n");
+                continue;
+            }
+
+            int user_id;
+            char room[20], date[20];
+            printf("Enter your user id: ");
+            if (scanf("%d", &user_id) != 1 || user_id <= 0)
+            {
+                while(getchar() != '\n'); // Clear input buffer
+                printf("Invalid user id.\n");
+                continue;
+            }
+            printf("Enter room number (e.g. S101): ");
+            scanf("%19s", room);
+            printf("Enter date (YYYY-MM-DD): ");
+            scanf("%19s", date);
+
+            int time_selection;
+            printTimeSlots();
+            do
+            {
+                printf("\nEnter time slot number (1-5): ");
+                scanf("%d", &time_selection);
+            } while (time_selection < 1 || time_selection > 5);
+            char *time_slots[] = {"9:00-10:30", "10:30-12:00", "12:00-2:00", "2:00-3:30", "3:30-5:00"};
+            char *selected_time_slot = time_slots[time_selection - 1];
+
+            int result;
+            if (user_selection == 4)
+            {
+                result = reserveRoom(reservation_book, user_id, room, date, selected_time_slot);
+            }
+            else
+            {
+                result = releaseRoom(reservation_book, user_id, room, date, selected_time_slot);
+            }
+
+            if (result == RESERVE_OK)
+            {
+                printf("Done: room %s on %s, Time Slot %s.\n", room, date, selected_time_slot);
+            }
+            else if (result == RESERVE_TAKEN)
+            {
+                printf("Room %s is already taken at that time.\n", room);
+            }
+            else if (result == RESERVE_NOT_HOLDER)
+            {
+                printf("You do not hold room %s at that time.\n", room);
+            }
+            else if (result == RESERVE_LOG_FAILED)
+            {
+                printf("Error: Unable to save the change to %s.\n", reservations_file);
+            }
+            else
+            {
+                printf("Invalid user id, room, date or weekend date.\n");
+            }
+        }
+        // This condition will print all rooms reserved by a user
+        else if (user_selection == 6)
+        {
+            if (reservation_book == NULL)
+            {
+                printf("Reservations are not available.\n");
+                continue;
+            }
+
+            int user_id;
+            printf("Enter your user id: ");
+            if (scanf("%d", &user_id) != 1 || user_id <= 0)
+            {
+                while(getchar() != '\n'); // Clear input buffer
+                printf("Invalid user id.\n");
+                continue;
+            }
+
+            char **holds = listReservations(reservation_book, user_id);
+            printf("%-12s%-15s%-10s\n", "Date", "Time", "Room");
+            printf("=====================================\n");
+            for(int i = 0; holds[i] != NULL; i++)
+            {
+                char date[20], time_slot[20], room[20];
+                sscanf(holds[i], "%[^,],%[^,],%s", date, time_slot, room);
+                printf("%-12s%-15s%-10s\n", date, time_slot, room);
+                free(holds[i]);
+            }
+            if (holds[0] == NULL)
+            {
+                printf("No reservations\n");
+            }
+            free(holds);
+        }
+        // This condition will print slots where sections, instructors and a room are all free
+        else if (user_selection == 7)
+        {
+            if (reservation_book == NULL)
+            {
+                printf("Reservations are not available.\n");
+                continue;
+            }
+
+            // Read whitespace separated sections and room numbers, and one instructor per line
+            char sections_line[200], instructors_line[200], rooms_line[200];
+            printf("Enter sections separated by spaces (e.g. 3B 5A): ");
+            fgets(sections_line, sizeof(sections_line), stdin);
+            printf("Enter instructors separated by ';' (e.g. Dr. Lee;Ms. Davis): ");
+            fgets(instructors_line, sizeof(instructors_line), stdin);
+            printf("Enter candidate rooms separated by spaces, or 'all': ");
+            fgets(rooms_line, sizeof(rooms_line), stdin);
+            sections_line[strcspn(sections_line, "\n")] = 0;
+            instructors_line[strcspn(instructors_line, "\n")] = 0;
+            rooms_line[strcspn(rooms_line, "\n")] = 0;
+
+            char *sections[20], *instructors[20], *rooms[MAX_RESERVABLE_ROOMS];
+            int section_count = 0, instructor_count = 0, room_count = 0;
+            for (char *token = strtok(sections_line, " "); token != NULL && section_count < 20; token = strtok(NULL, " "))
+            {
+                sections[section_count++] = token;
+            }
+            for (char *token = strtok(instructors_line, ";"); token != NULL && instructor_count < 20; token = strtok(NULL, ";"))
+            {
+                while (*token == ' ')
+                {
+                    token++;
+                }
+                instructors[instructor_count++] = token;
+            }
+            for (char *token = strtok(rooms_line, " "); token != NULL && room_count < MAX_RESERVABLE_ROOMS; token = strtok(NULL, " "))
+            {
+                rooms[room_count++] = token;
+            }
+            int all_rooms = room_count == 0 || strcmp(rooms[0], "all") == 0;
+
+            int free_slot_count;
+            CommonFreeSlot *free_slots = findCommonFreeSlots(reservation_book, timetable_file,
+                                                             sections, section_count, instructors, instructor_count,
+                                                             all_rooms ? NULL : rooms, room_count, &free_slot_count);
+            if (free_slots == NULL)
+            {
+                continue;
+            }
+
+            printf("%-12s%-15s%-10s\n", "Date", "Time", "Free rooms");
+            printf("=====================================\n");
+            for (int i = 0; i < free_slot_count && i < MAX_FREE_SLOTS_SHOWN; i++)
+            {
+                printf("%-12s%-15s%-10d\n", free_slots[i].date, free_slots[i].time_slot, free_slots[i].free_room_count);
+            }
+            if (free_slot_count == 0)
+            {
+                printf("No common free time\n");
+            }
+            else if (free_slot_count > MAX_FREE_SLOTS_SHOWN)
+            {
+                printf("Showing the best %d of %d common free slots.\n", MAX_FREE_SLOTS_SHOWN, free_slot_count);
+            }
+            else
+            {
+                printf("%d common free slots.\n", free_slot_count);
+            }
+            free(free_slots);
+        }
+        // This condition will print a timetable or free rooms as they were in an earlier version
+        else if (user_selection == 8)
+        {
+            if (current_version < 0)
+            {
+                printf("Timetable history is not available.\n");
+                continue;
+            }
+
+            int version, query;
+            printf("Stored timetable versions: 0-%d (current is %d)\n", current_version, current_version);
+            do
+            {
+                printf("Enter version number: ");
+                scanf("%d", &version);
+            } while (version < 0 || version > current_version);
+            do
+            {
+                printf("1. Timetable of a section.\n");
+                printf("2. Free rooms for a specific day.\n");
+                scanf("%d", &query);
+            } while (query != 1 && query != 2);
+
+            if (query == 1)
+            {
+                int student_semester;
+                char student_section;
+                do
+                {
+                    printf("Enter your semester (1-8): ");
+                    scanf("%d", &student_semester);
+                    printf("Enter your section (A-D): ");
+                    scanf(" %c", &student_section);
+                } while (student_semester < 1 || student_semester > 8 || (student_section != 'A' && student_section != 'B' &&
+                            student_section != 'C' && student_section != 'D'));
+
+                char **time_table = getTimeTableAt(timetable_history, version, student_semester, student_section);
+                printf("\nTime Table of Semester %d Section %c in version %d:\n", student_semester, student_section, version);
+                printf("%-12s%-15s%-20s%-20s%-10s\n", "Day", "Time", "Subject", "Instructor", "Room");
+                printf("=======================================================================\n");
+                for (int i = 0; time_table[i] != NULL; i++)
+                {
+                    int entry_semester;
+                    char entry_section, day[20], time[20], subject[50], instructor[50], room[20];
+                    sscanf(time_table[i], "%d,%c,%[^,],%[^,],%[^,],%[^,],%s", &entry_semester, &entry_section, day, time, subject, instructor, room);
+                    printf("%-12s%-15s%-20s%-20s%-10s\n", day, time, subject, instructor, room);
+                    free(time_table[i]);
+                }
+                free(time_table);
+            }
+            else
+            {
+                char selected_day[20];
+                printf("Enter day (Monday-Friday): ");
+                scanf("%19s", selected_day);
+
+                int time_selection;
+                printTimeSlots();
+                do
+                {
+                    printf("\nEnter time slot number (1-5): ");
+                    scanf("%d", &time_selection);
+                } while (time_selection < 1 || time_selection > 5);
+                char *selected_time_slot = getSlotName(time_selection - 1);
+
+                char **free_rooms = checkFreeSlotsForDayAt(timetable_history, version, selected_day, selected_time_slot);
+                if (free_rooms == NULL)
+                {
+                    printf("Invalid day %s.\n", selected_day);
+                    continue;
+                }
+                printf("The free rooms for %s, Time Slot %s in version %d are:\n", selected_day, selected_time_slot, version);
+                if (free_rooms[0] == NULL)
+                {
+                    printf("No room aviable\n");
+                }
+                for (int i = 0; free_rooms[i] != NULL; i++)
+                {
+                    printf("%s\n", free_rooms[i]);
+                    free(free_rooms[i]);
+                }
+                free(free_rooms);
+            }
+        }
+        else if (user_selection == 9)
         {
+            closeTimetableHistory(timetable_history);
+            closeReservationBook(reservation_book);
             printf("Exiting the program. Goodbye!\n");
             break;
         }
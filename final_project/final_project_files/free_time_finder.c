@@ -0,0 +1,286 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "free_time_finder.h"
+
+/* Function Declarations
+ * findCommonFreeSlots: Intersects busy bitmaps of sections, instructors and rooms
+ *
+ * Every entity gets a bitmap with one bit per (term day, slot). A slot is free
+ * for everyone when its bit is clear in all bitmaps, so the whole term is
+ * checked by OR-ing the bitmaps together word by word.
+ */
+
+//==============================================================================
+/**
+ * markWeeklyClass - Marks a weekly class in a busy bitmap for every week of the term
+ * @param bitmap: Busy bitmap with CALENDAR_WORDS words
+ * @param term_weekdays: tm_wday of every term day
+ * @param weekday: Class day (0 = Monday)
+ * @param slot: Class slot
+ */
+static void markWeeklyClass(uint64_t *bitmap, int *term_weekdays, int weekday, int slot)
+{
+    for (int term_day = 0; term_day < MAX_TERM_DAYS; term_day++)
+    {
+        if (term_weekdays[term_day] == weekday + 1)
+        {
+            int bit = term_day * TOTAL_SLOTS + slot;
+            bitmap[bit / 64] |= (uint64_t)1 << (bit % 64);
+        }
+    }
+}
+
+//==============================================================================
+/**
+ * compareFreeSlots - Orders slots by free room count, then by date and slot
+ */
+static int compareFreeSlots(const void *first, const void *second)
+{
+    const CommonFreeSlot *a = first;
+    const CommonFreeSlot *b = second;
+    if (a->free_room_count != b->free_room_count)
+    {
+        return b->free_room_count - a->free_room_count;
+    }
+    if (a->term_day != b->term_day)
+    {
+        return a->term_day - b->term_day;
+    }
+    return a->slot - b->slot;
+}
+
+//==============================================================================
+/**
+ * findCommonFreeSlots - Finds time where a group of sections, instructors and a room are all free
+ * @param book: Reservation book with room occupancy for the term
+ * @param timetable_file: Path to timetable file
+ * @param sections: Sections such as "3B"
+ * @param section_count: Number of sections
+ * @param instructors: Instructor names as written in the timetable
+ * @param instructor_count: Number of instructors
+ * @param room_filter: Candidate room numbers, or NULL for all rooms
+ * @param room_filter_count: Number of candidate rooms
+ * @param result_count: Output number of slots found
+ * @return: Array of free slots sorted by free room count, or NULL on errors
+ *
+ * Weekends and slots without a free candidate room are treated as busy. Room
+ * occupancy includes reservations held in the book. A section, instructor or
+ * room that does not appear in the timetable or the room list is reported as
+ * an error, since ignoring it would make its busy time look free.
+ */
+CommonFreeSlot *findCommonFreeSlots(ReservationBook *book, char *timetable_file,
+                                    char **sections, int section_count,
+                                    char **instructors, int instructor_count,
+                                    char **room_filter, int room_filter_count,
+                                    int *result_count)
+{
+    *result_count = 0;
+
+    // Every unknown input is reported before giving up
+    int unknown_count = 0;
+
+    // Bit mask of the candidate rooms
+    uint64_t room_mask = 0;
+    if (room_filter == NULL)
+    {
+        room_mask = book->room_count == 64 ? ~(uint64_t)0 : ((uint64_t)1 << book->room_count) - 1;
+    }
+    for (int i = 0; room_filter != NULL && i < room_filter_count; i++)
+    {
+        int room_index = getRoomIndex(book, room_filter[i]);
+        if (room_index < 0)
+        {
+            fprintf(stderr, "Error: Unknown room %s.\n", room_filter[i]);
+            unknown_count++;
+            continue;
+        }
+        room_mask |= (uint64_t)1 << room_index;
+    }
+
+    // Parse the sections once instead of for every timetable line
+    int *section_semesters = malloc(sizeof(int) * (section_count + 1));
+    char *section_letters = malloc(section_count + 1);
+    for (int i = 0; i < section_count; i++)
+    {
+        char extra;
+        if (sscanf(sections[i], "%d%c%c", &section_semesters[i], &section_letters[i], &extra) != 2)
+        {
+            fprintf(stderr, "Error: Invalid section %s, expected semester and letter such as 3B.\n", sections[i]);
+            section_semesters[i] = -1; // Never matches a timetable line
+            unknown_count++;
+        }
+    }
+
+    // Day of the week for every term day
+    char date[20];
+    int term_weekdays[MAX_TERM_DAYS];
+    int start_weekday = getTermDate(book, 0, date, sizeof(date));
+    for (int term_day = 0; term_day < MAX_TERM_DAYS; term_day++)
+    {
+        term_weekdays[term_day] = (start_weekday + term_day) % 7;
+    }
+
+    // One busy bitmap per section and instructor, plus one for weekends and rooms
+    int entity_count = section_count + instructor_count + 1;
+    uint64_t (*busy)[CALENDAR_WORDS] = calloc(entity_count, sizeof(*busy));
+    int *class_counts = calloc(entity_count, sizeof(int));
+    if (busy == NULL || class_counts == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed!\n");
+        free(busy);
+        free(class_counts);
+        free(section_semesters);
+        free(section_letters);
+        return NULL;
+    }
+
+    FILE *file = fopen(timetable_file, "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: Unable to open the file %s.\n", timetable_file);
+        free(busy);
+        free(class_counts);
+        free(section_semesters);
+        free(section_letters);
+        return NULL;
+    }
+
+    char timetable_entry[100];
+    while (fgets(timetable_entry, sizeof(timetable_entry), file))
+    {
+        int entry_semester;
+        char entry_section, entry_day[20], entry_time[20], instructor[50];
+        if (sscanf(timetable_entry, "%d,%c,%19[^,],%19[^,],%*[^,],%49[^,]",
+                   &entry_semester, &entry_section, entry_day, entry_time, instructor) != 5)
+        {
+            continue; // Header or malformed line
+        }
+
+        int day = getWeekdayIndex(entry_day);
+        int slot = getSlotIndex(entry_time);
+        if (day < 0 || slot < 0)
+        {
+            continue;
+        }
+
+        for (int i = 0; i < section_count; i++)
+        {
+            if (section_semesters[i] == entry_semester && section_letters[i] == entry_section)
+            {
+                markWeeklyClass(busy[i], term_weekdays, day, slot);
+                class_counts[i]++;
+            }
+        }
+        for (int i = 0; i < instructor_count; i++)
+        {
+            if (strcmp(instructors[i], instructor) == 0)
+            {
+                markWeeklyClass(busy[section_count + i], term_weekdays, day, slot);
+                class_counts[section_count + i]++;
+            }
+        }
+    }
+    fclose(file);
+
+    // A misspelled name has no classes and would look free all term
+    for (int i = 0; i < section_count + instructor_count; i++)
+    {
+        if (class_counts[i] == 0 && (i >= section_count || section_semesters[i] >= 0))
+        {
+            fprintf(stderr, "Error: No classes found for %s %s.\n", i < section_count ? "section" : "instructor",
+                    i < section_count ? sections[i] : instructors[i - section_count]);
+            unknown_count++;
+        }
+    }
+    free(class_counts);
+    free(section_semesters);
+    free(section_letters);
+    if (unknown_count > 0)
+    {
+        free(busy);
+        return NULL;
+    }
+
+    // Weekends and slots where every candidate room is taken
+    uint64_t *blocked = busy[entity_count - 1];
+    for (int term_day = 0; term_day < MAX_TERM_DAYS; term_day++)
+    {
+        int weekend = term_weekdays[term_day] == 0 || term_weekdays[term_day] == 6;
+        for (int slot = 0; slot < TOTAL_SLOTS; slot++)
+        {
+            uint64_t free_rooms = ~atomic_load(&book->occupancy[term_day][slot]) & room_mask;
+            if (weekend || free_rooms == 0)
+            {
+                int bit = term_day * TOTAL_SLOTS + slot;
+                blocked[bit / 64] |= (uint64_t)1 << (bit % 64);
+            }
+        }
+    }
+
+    // Intersect free time: a slot is free only if no bitmap has it busy
+    uint64_t any_busy[CALENDAR_WORDS] = {0};
+    for (int entity = 0; entity < entity_count; entity++)
+    {
+        for (int word = 0; word < CALENDAR_WORDS; word++)
+        {
+            any_busy[word] |= busy[entity][word];
+        }
+    }
+    free(busy);
+
+    int free_count = 0;
+    for (int word = 0; word < CALENDAR_WORDS; word++)
+    {
+        uint64_t free_bits = ~any_busy[word];
+        if (word == CALENDAR_WORDS - 1 && CALENDAR_BITS % 64 != 0)
+        {
+            free_bits &= ((uint64_t)1 << (CALENDAR_BITS % 64)) - 1;
+        }
+        free_count += __builtin_popcountll(free_bits);
+    }
+
+    CommonFreeSlot *free_slots = malloc(sizeof(CommonFreeSlot) * (free_count + 1));
+    if (free_slots == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed!\n");
+        return NULL;
+    }
+
+    // Collect the free slots with their number of candidate rooms
+    int count = 0;
+    for (int word = 0; word < CALENDAR_WORDS; word++)
+    {
+        uint64_t free_bits = ~any_busy[word];
+        while (free_bits != 0)
+        {
+            int bit = word * 64 + __builtin_ctzll(free_bits);
+            free_bits &= free_bits - 1;
+            if (bit >= CALENDAR_BITS)
+            {
+                break;
+            }
+
+            // Rooms may have been reserved since the blocked bitmap was built
+            int term_day = bit / TOTAL_SLOTS;
+            int slot = bit % TOTAL_SLOTS;
+            uint64_t free_rooms = ~atomic_load(&book->occupancy[term_day][slot]) & room_mask;
+            if (free_rooms == 0)
+            {
+                continue;
+            }
+
+            CommonFreeSlot *free_slot = &free_slots[count++];
+            free_slot->term_day = term_day;
+            free_slot->slot = slot;
+            free_slot->time_slot = getSlotName(slot);
+            free_slot->free_room_count = __builtin_popcountll(free_rooms);
+            getTermDate(book, term_day, free_slot->date, sizeof(free_slot->date));
+        }
+    }
+
+    qsort(free_slots, count, sizeof(CommonFreeSlot), compareFreeSlots);
+    *result_count = count;
+    return free_slots;
+}
@@ -0,0 +1,26 @@
+#ifndef FREE_TIME_FINDER_H
+#define FREE_TIME_FINDER_H
+
+#include "room_reservation.h"
+
+#define CALENDAR_BITS (MAX_TERM_DAYS * TOTAL_SLOTS) // One bit per (term day, slot)
+#define CALENDAR_WORDS ((CALENDAR_BITS + 63) / 64)
+
+typedef struct CommonFreeSlot
+{
+    int term_day;
+    int slot;
+    char date[20];
+    char *time_slot;
+    int free_room_count; // Rooms from the filter that are free in this slot
+} CommonFreeSlot;
+
+// Get every (date, slot) where all sections and instructors and at least one filtered room are free,
+// ranked by the number of free rooms. sections are strings such as "3B", a room filter of NULL means all rooms.
+CommonFreeSlot *findCommonFreeSlots(ReservationBook *book, char *timetable_file,
+                                    char **sections, int section_count,
+                                    char **instructors, int instructor_count,
+                                    char **room_filter, int room_filter_count,
+                                    int *result_count);
+
+#endif
@@ -0,0 +1,690 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "room_reservation.h"
+
+/* Function Declarations
+ * openReservationBook: Builds per-date occupancy words from the timetable
+ * reserveRoom: Claims a free room with a compare-and-swap on its occupancy word
+ * releaseRoom: Gives a held room back
+ * listReservations: Lists all holds of one user
+ * syncReservationLog: Waits until all log records are on disk
+ */
+
+static char *time_slots[TOTAL_SLOTS] = {"9:00-10:30", "10:30-12:00", "12:00-2:00", "2:00-3:30", "3:30-5:00"};
+static char *weekdays[TOTAL_WEEKDAYS] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
+
+//==============================================================================
+/**
+ * getSlotIndex - Converts a time slot string into its slot number
+ * @param time_slot: Time slot such as "9:00-10:30"
+ * @return: Slot index 0-4, or -1 if the slot is unknown
+ *
+ * The timetable file writes the last slot as "3:00-5:00" while the menu
+ * prints "3:30-5:00", so both spellings map to the last slot.
+ */
+int getSlotIndex(char *time_slot)
+{
+    for (int i = 0; i < TOTAL_SLOTS; i++)
+    {
+        if (strcmp(time_slot, time_slots[i]) == 0)
+        {
+            return i;
+        }
+    }
+    if (strcmp(time_slot, "3:00-5:00") == 0)
+    {
+        return TOTAL_SLOTS - 1;
+    }
+    return -1;
+}
+
+//==============================================================================
+/**
+ * getSlotName - Converts a slot number back into its time slot string
+ * @param slot: Slot index 0-4
+ * @return: Time slot string, or NULL if the slot is out of range
+ */
+char *getSlotName(int slot)
+{
+    if (slot < 0 || slot >= TOTAL_SLOTS)
+    {
+        return NULL;
+    }
+    return time_slots[slot];
+}
+
+//==============================================================================
+/**
+ * getWeekdayIndex - Converts a day name into its weekday number
+ * @param day: Day name (Monday-Friday)
+ * @return: Day index 0-4, or -1 if the day is unknown
+ */
+int getWeekdayIndex(char *day)
+{
+    for (int i = 0; i < TOTAL_WEEKDAYS; i++)
+    {
+        if (strcmp(day, weekdays[i]) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//==============================================================================
+/**
+ * findRoomIndex - Finds the position of a room in a list of room numbers
+ * @param rooms: Array of room numbers
+ * @param room_count: Number of rooms in the array
+ * @param room: Room number such as "S101"
+ * @return: Room index, or -1 if the room is unknown
+ */
+int findRoomIndex(char **rooms, int room_count, char *room)
+{
+    for (int i = 0; i < room_count; i++)
+    {
+        if (strcmp(rooms[i], room) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//==============================================================================
+/**
+ * getRoomIndex - Finds the bit position of a room in the occupancy words
+ * @param book: Reservation book
+ * @param room: Room number such as "S101"
+ * @return: Room index, or -1 if the room is unknown
+ */
+int getRoomIndex(ReservationBook *book, char *room)
+{
+    return findRoomIndex(book->rooms, book->room_count, room);
+}
+
+//==============================================================================
+/**
+ * parseDate - Converts a "YYYY-MM-DD" string into a local noon timestamp
+ * @param date: Date string
+ * @param weekday: Output tm_wday of the date (0 = Sunday)
+ * @return: Timestamp, or -1 if the date cannot be parsed
+ *
+ * Noon is used so that daylight saving changes never move the date.
+ */
+static time_t parseDate(char *date, int *weekday)
+{
+    int year, month, day;
+    if (sscanf(date, "%d-%d-%d", &year, &month, &day) != 3)
+    {
+        return -1;
+    }
+
+    struct tm date_time = {0};
+    date_time.tm_year = year - 1900;
+    date_time.tm_mon = month - 1;
+    date_time.tm_mday = day;
+    date_time.tm_hour = 12;
+    date_time.tm_isdst = -1;
+
+    time_t timestamp = mktime(&date_time);
+    if (weekday != NULL)
+    {
+        *weekday = date_time.tm_wday;
+    }
+    return timestamp;
+}
+
+//==============================================================================
+/**
+ * getTermDay - Converts a date into a day number of the term
+ * @param book: Reservation book
+ * @param date: Date string (YYYY-MM-DD)
+ * @return: Day number within the term, or -1 if outside the term or on a weekend
+ *
+ * The term dates are sorted as strings, so the date is found with a binary
+ * search instead of mktime, which takes a global lock on every call.
+ */
+static int getTermDay(ReservationBook *book, char *date)
+{
+    int year, month, day;
+    if (sscanf(date, "%d-%d-%d", &year, &month, &day) != 3 || year < 0 || year > 9999 || month < 1 ||
+        month > 12 || day < 1 || day > 31)
+    {
+        return -1;
+    }
+    char term_date[TERM_DATE_SIZE];
+    snprintf(term_date, sizeof(term_date), "%04d-%02d-%02d", year, month, day);
+
+    int low = 0, high = MAX_TERM_DAYS - 1;
+    while (low <= high)
+    {
+        int middle = (low + high) / 2;
+        int order = strcmp(term_date, book->term_dates[middle]);
+        if (order == 0)
+        {
+            int weekday = book->term_weekdays[middle];
+            return (weekday == 0 || weekday == 6) ? -1 : middle;
+        }
+        if (order < 0)
+        {
+            high = middle - 1;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+    return -1;
+}
+
+//==============================================================================
+/**
+ * getTermDate - Converts a day number of the term back into a date
+ * @param book: Reservation book
+ * @param term_day: Day number within the term
+ * @param date: Output buffer for the "YYYY-MM-DD" string
+ * @param date_size: Size of the output buffer
+ * @return: tm_wday of the date (0 = Sunday)
+ *
+ * The dates are computed when the book is opened, so this is safe to call
+ * from any number of threads.
+ */
+int getTermDate(ReservationBook *book, int term_day, char *date, int date_size)
+{
+    snprintf(date, date_size, "%s", book->term_dates[term_day]);
+    return book->term_weekdays[term_day];
+}
+
+//==============================================================================
+/**
+ * computeTermDates - Fills in the date and weekday of every term day
+ * @param book: Reservation book with term_start set
+ */
+static void computeTermDates(ReservationBook *book)
+{
+    struct tm start_time;
+    localtime_r(&book->term_start, &start_time);
+    for (int term_day = 0; term_day < MAX_TERM_DAYS; term_day++)
+    {
+        // mktime normalizes the day of month across month and year ends
+        struct tm date_time = start_time;
+        date_time.tm_mday += term_day;
+        date_time.tm_isdst = -1;
+        mktime(&date_time);
+        strftime(book->term_dates[term_day], TERM_DATE_SIZE, "%Y-%m-%d", &date_time);
+        book->term_weekdays[term_day] = date_time.tm_wday;
+    }
+}
+
+//==============================================================================
+/**
+ * readRoomNames - Reads room numbers into an array
+ * @param rooms_file: Path to the file containing one room number per line
+ * @param rooms: Output array of room numbers
+ * @param max_rooms: Capacity of the output array
+ * @return: Number of rooms read, or -1 if the file cannot be opened
+ *
+ * Trailing spaces are trimmed and blank lines skipped. Rooms past
+ * max_rooms are ignored because they have no occupancy bit.
+ */
+int readRoomNames(char *rooms_file, char **rooms, int max_rooms)
+{
+    FILE *file = fopen(rooms_file, "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: Unable to open the file %s.\n", rooms_file);
+        return -1;
+    }
+
+    char line[32];
+    int count = 0;
+    while (fgets(line, sizeof(line), file) && count < max_rooms)
+    {
+        int length = strlen(line);
+        while (length > 0 && isspace((unsigned char)line[length - 1]))
+        {
+            line[--length] = 0;
+        }
+        if (length == 0)
+        {
+            continue;
+        }
+        rooms[count] = malloc(length + 1);
+        strcpy(rooms[count], line);
+        count++;
+    }
+    fclose(file);
+    return count;
+}
+
+//==============================================================================
+/**
+ * applyLogRecord - Replays one reservation log line
+ * @param book: Reservation book
+ * @param record: Log line "R,user,date,slot,room" or "U,user,date,slot,room"
+ *
+ * Records of one room are logged in order: a hold is only given to its user
+ * once its R record is on disk, and the room stays taken until the U record
+ * of its release is written. A release is still only replayed when the
+ * releasing user holds the room, so a stray U record never frees another hold.
+ */
+static void applyLogRecord(ReservationBook *book, char *record)
+{
+    char type, date[20], time_slot[20], room[20];
+    int user_id;
+    if (sscanf(record, "%c,%d,%19[^,],%19[^,],%19s", &type, &user_id, date, time_slot, room) != 5)
+    {
+        return;
+    }
+
+    int term_day = getTermDay(book, date);
+    int slot = getSlotIndex(time_slot);
+    int room_index = getRoomIndex(book, room);
+    if (term_day < 0 || slot < 0 || room_index < 0)
+    {
+        return;
+    }
+
+    uint64_t room_bit = (uint64_t)1 << room_index;
+    if (type == 'R')
+    {
+        atomic_fetch_or(&book->occupancy[term_day][slot], room_bit);
+        atomic_store(&book->holders[term_day][slot][room_index], user_id);
+    }
+    else if (type == 'U')
+    {
+        int expected_holder = user_id;
+        if (atomic_compare_exchange_strong(&book->holders[term_day][slot][room_index], &expected_holder, 0))
+        {
+            atomic_fetch_and(&book->occupancy[term_day][slot], ~room_bit);
+        }
+    }
+}
+
+//==============================================================================
+/**
+ * waitForLogSync - Waits until a log record is on disk
+ * @param book: Reservation book
+ * @param record_number: Number of the record, counted from 1 since the book was opened
+ * @return: true once the record is synced, false if a sync failed
+ *
+ * The first waiter that finds no sync running fsyncs everything appended so
+ * far while the others wait, so one disk sync covers a whole group of
+ * bookings. No lock is held during the fsync itself.
+ */
+static bool waitForLogSync(ReservationBook *book, long record_number)
+{
+    pthread_mutex_lock(&book->sync_lock);
+    while (book->synced_records < record_number && !atomic_load(&book->log_failed))
+    {
+        if (book->log_syncing)
+        {
+            pthread_cond_wait(&book->sync_done, &book->sync_lock);
+            continue;
+        }
+
+        // Every record counted here was written before the fsync starts
+        book->log_syncing = true;
+        long target = atomic_load(&book->appended_records);
+        pthread_mutex_unlock(&book->sync_lock);
+        int result = fsync(book->log_fd);
+        pthread_mutex_lock(&book->sync_lock);
+
+        book->log_syncing = false;
+        if (result != 0)
+        {
+            atomic_store(&book->log_failed, true); // The file state is unknown after a failed fsync
+        }
+        else if (target > book->synced_records)
+        {
+            book->synced_records = target;
+        }
+        pthread_cond_broadcast(&book->sync_done);
+    }
+    bool synced = book->synced_records >= record_number;
+    pthread_mutex_unlock(&book->sync_lock);
+    return synced;
+}
+
+//==============================================================================
+/**
+ * writeLogRecord - Writes one record to the end of the reservation log
+ * @param book: Reservation book
+ * @param type: 'R' for a reservation, 'U' for a release
+ * @return: true if the whole record was written
+ *
+ * The log is opened with O_APPEND, so each record is written by one write()
+ * call without a lock and concurrent records never interleave.
+ */
+static bool writeLogRecord(ReservationBook *book, char type, int user_id, int term_day, int slot, int room_index)
+{
+    char record[LOG_RECORD_SIZE];
+    int length = snprintf(record, sizeof(record), "%c,%d,%s,%s,%s\n", type, user_id, book->term_dates[term_day],
+                          time_slots[slot], book->rooms[room_index]);
+    return length < (int)sizeof(record) && write(book->log_fd, record, length) == length;
+}
+
+//==============================================================================
+/**
+ * appendLogRecord - Appends one record to the reservation log and waits until it is on disk
+ * @param book: Reservation book
+ * @param type: 'R' for a reservation, 'U' for a release
+ * @return: true if the record is durable or there is no log, false on write or sync errors
+ *
+ * After the first write or sync error the log is poisoned and no new record
+ * is written. A hold that was written but not synced may still be in the
+ * file, so it is cancelled with a U record to keep replay from restoring a
+ * booking its user was told had failed.
+ */
+static bool appendLogRecord(ReservationBook *book, char type, int user_id, int term_day, int slot, int room_index)
+{
+    if (book->log_fd < 0)
+    {
+        return true;
+    }
+    if (atomic_load(&book->log_failed))
+    {
+        return false;
+    }
+
+    if (writeLogRecord(book, type, user_id, term_day, slot, room_index))
+    {
+        long record_number = atomic_fetch_add(&book->appended_records, 1) + 1;
+        if (waitForLogSync(book, record_number))
+        {
+            return true;
+        }
+    }
+    atomic_store(&book->log_failed, true);
+
+    if (type == 'R' && writeLogRecord(book, 'U', user_id, term_day, slot, room_index))
+    {
+        fsync(book->log_fd);
+    }
+    return false;
+}
+
+//==============================================================================
+/**
+ * openReservationBook - Builds the occupancy words for every day of the term
+ * @param timetable_file: Path to timetable file
+ * @param rooms_file: Path to file containing room numbers
+ * @param term_start_date: First day of the term (YYYY-MM-DD)
+ * @param log_file: Path to the reservation log, or NULL to keep holds in memory only
+ * @return: Reservation book, or NULL on errors
+ *
+ * Every weekday of the term starts with the rooms used by its weekly classes.
+ * Holds recorded in the log are then replayed on top.
+ */
+ReservationBook *openReservationBook(char *timetable_file, char *rooms_file, char *term_start_date, char *log_file)
+{
+    ReservationBook *book = calloc(1, sizeof(ReservationBook));
+    if (book == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed!\n");
+        return NULL;
+    }
+    book->log_fd = -1;
+    pthread_mutex_init(&book->sync_lock, NULL);
+    pthread_cond_init(&book->sync_done, NULL);
+
+    book->term_start = parseDate(term_start_date, NULL);
+    if (book->term_start == -1)
+    {
+        fprintf(stderr, "Error: Invalid term start date %s.\n", term_start_date);
+        closeReservationBook(book);
+        return NULL;
+    }
+    computeTermDates(book);
+
+    int room_count = readRoomNames(rooms_file, book->rooms, MAX_RESERVABLE_ROOMS);
+    if (room_count < 0)
+    {
+        closeReservationBook(book);
+        return NULL;
+    }
+    book->room_count = room_count;
+
+    FILE *file = fopen(timetable_file, "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: Unable to open the file %s.\n", timetable_file);
+        closeReservationBook(book);
+        return NULL;
+    }
+
+    // Weekly occupancy of every (weekday, slot) from the timetable
+    uint64_t weekly_occupancy[TOTAL_WEEKDAYS][TOTAL_SLOTS] = {0};
+    char timetable_entry[100];
+    while (fgets(timetable_entry, sizeof(timetable_entry), file))
+    {
+        char entry_day[20], entry_time[20], room[20];
+        if (sscanf(timetable_entry, "%*d,%*c,%19[^,],%19[^,],%*[^,],%*[^,],%19s", entry_day, entry_time, room) != 3)
+        {
+            continue; // Header or malformed line
+        }
+
+        int day = getWeekdayIndex(entry_day);
+        int slot = getSlotIndex(entry_time);
+        int room_index = getRoomIndex(book, room);
+        if (day >= 0 && slot >= 0 && room_index >= 0)
+        {
+            weekly_occupancy[day][slot] |= (uint64_t)1 << room_index;
+        }
+    }
+    fclose(file);
+
+    // Copy the weekly pattern onto each weekday of the term
+    for (int term_day = 0; term_day < MAX_TERM_DAYS; term_day++)
+    {
+        int weekday = book->term_weekdays[term_day]; // 0 = Sunday
+        for (int slot = 0; slot < TOTAL_SLOTS; slot++)
+        {
+            uint64_t word = (weekday >= 1 && weekday <= 5) ? weekly_occupancy[weekday - 1][slot] : 0;
+            atomic_init(&book->occupancy[term_day][slot], word);
+        }
+    }
+
+    if (log_file != NULL)
+    {
+        // Replay earlier holds before opening the log for appending
+        FILE *existing_log = fopen(log_file, "r");
+        if (existing_log != NULL)
+        {
+            char record[LOG_RECORD_SIZE];
+            while (fgets(record, sizeof(record), existing_log))
+            {
+                // A record without its line end was cut off by a failed write
+                if (strchr(record, '\n') != NULL)
+                {
+                    applyLogRecord(book, record);
+                }
+            }
+            fclose(existing_log);
+        }
+
+        book->log_fd = open(log_file, O_WRONLY | O_APPEND | O_CREAT, 0644);
+        if (book->log_fd < 0)
+        {
+            fprintf(stderr, "Error: Unable to open the file %s.\n", log_file);
+            closeReservationBook(book);
+            return NULL;
+        }
+    }
+    return book;
+}
+
+//==============================================================================
+/**
+ * reserveRoom - Claims a room for one date and time slot
+ * @param book: Reservation book
+ * @param user_id: Id of the user making the hold (must be positive)
+ * @param room: Room number
+ * @param date: Date string (YYYY-MM-DD)
+ * @param time_slot: Time slot string
+ * @return: RESERVE_OK, RESERVE_TAKEN if the room is busy, RESERVE_INVALID on bad input,
+ *          RESERVE_LOG_FAILED if the hold could not be written to disk
+ *
+ * The room bit is set with a compare-and-swap on the occupancy word, so two
+ * users racing for the same free room never both succeed and no lock is taken.
+ * The user only becomes the holder once the hold is in the log on disk, so
+ * a hold cannot be released before its R record is written.
+ */
+int reserveRoom(ReservationBook *book, int user_id, char *room, char *date, char *time_slot)
+{
+    int term_day = getTermDay(book, date);
+    int slot = getSlotIndex(time_slot);
+    int room_index = getRoomIndex(book, room);
+    if (user_id <= 0 || term_day < 0 || slot < 0 || room_index < 0)
+    {
+        return RESERVE_INVALID;
+    }
+
+    _Atomic uint64_t *word = &book->occupancy[term_day][slot];
+    uint64_t room_bit = (uint64_t)1 << room_index;
+    uint64_t current = atomic_load(word);
+    do
+    {
+        if (current & room_bit)
+        {
+            return RESERVE_TAKEN;
+        }
+    } while (!atomic_compare_exchange_weak(word, &current, current | room_bit));
+
+    if (!appendLogRecord(book, 'R', user_id, term_day, slot, room_index))
+    {
+        atomic_fetch_and(word, ~room_bit);
+        return RESERVE_LOG_FAILED;
+    }
+    atomic_store(&book->holders[term_day][slot][room_index], user_id);
+    return RESERVE_OK;
+}
+
+//==============================================================================
+/**
+ * releaseRoom - Gives back a room held by the user
+ * @param book: Reservation book
+ * @param user_id: Id of the user who made the hold
+ * @param room: Room number
+ * @param date: Date string (YYYY-MM-DD)
+ * @param time_slot: Time slot string
+ * @return: RESERVE_OK, RESERVE_NOT_HOLDER if the user does not hold it, RESERVE_INVALID on bad input,
+ *          RESERVE_LOG_FAILED if the release could not be written to disk
+ *
+ * The holder is cleared first so only one release can win. The room bit is
+ * cleared after the U record is written, so no new hold of the room reaches
+ * the log before it. A release that fails to reach the log is still applied
+ * in memory; after a restart the hold comes back, so a room is never lost to
+ * two users.
+ */
+int releaseRoom(ReservationBook *book, int user_id, char *room, char *date, char *time_slot)
+{
+    int term_day = getTermDay(book, date);
+    int slot = getSlotIndex(time_slot);
+    int room_index = getRoomIndex(book, room);
+    if (user_id <= 0 || term_day < 0 || slot < 0 || room_index < 0)
+    {
+        return RESERVE_INVALID;
+    }
+
+    int expected_holder = user_id;
+    if (!atomic_compare_exchange_strong(&book->holders[term_day][slot][room_index], &expected_holder, 0))
+    {
+        return RESERVE_NOT_HOLDER;
+    }
+    bool logged = appendLogRecord(book, 'U', user_id, term_day, slot, room_index);
+    atomic_fetch_and(&book->occupancy[term_day][slot], ~((uint64_t)1 << room_index));
+    return logged ? RESERVE_OK : RESERVE_LOG_FAILED;
+}
+
+//==============================================================================
+/**
+ * listReservations - Lists every hold of one user
+ * @param book: Reservation book
+ * @param user_id: Id of the user
+ * @return: NULL terminated array of "date,time slot,room" strings, empty for ids below 1
+ *
+ * Free rooms have holder 0, so ids below 1 never hold anything.
+ */
+char **listReservations(ReservationBook *book, int user_id)
+{
+    int capacity = 8;
+    int count = 0;
+    char **holds = malloc(sizeof(char *) * capacity);
+
+    for (int term_day = 0; term_day < MAX_TERM_DAYS && user_id > 0; term_day++)
+    {
+        char *date = book->term_dates[term_day];
+        for (int slot = 0; slot < TOTAL_SLOTS; slot++)
+        {
+            for (int room_index = 0; room_index < book->room_count; room_index++)
+            {
+                if (atomic_load(&book->holders[term_day][slot][room_index]) != user_id)
+                {
+                    continue;
+                }
+
+                if (count + 1 >= capacity)
+                {
+                    capacity *= 2;
+                    holds = realloc(holds, sizeof(char *) * capacity);
+                }
+                char entry[64];
+                snprintf(entry, sizeof(entry), "%s,%s,%s", date, time_slots[slot], book->rooms[room_index]);
+                holds[count] = malloc(strlen(entry) + 1);
+                strcpy(holds[count], entry);
+                count++;
+            }
+        }
+    }
+    holds[count] = NULL;
+    return holds;
+}
+
+//==============================================================================
+/**
+ * syncReservationLog - Waits until every log record written so far is on disk
+ * @param book: Reservation book
+ * @return: true if the records are synced or there is no log, false if a sync failed
+ */
+bool syncReservationLog(ReservationBook *book)
+{
+    if (book->log_fd < 0)
+    {
+        return true;
+    }
+    return waitForLogSync(book, atomic_load(&book->appended_records));
+}
+
+//==============================================================================
+/**
+ * closeReservationBook - Syncs the log and frees all memory of the book
+ * @param book: Reservation book
+ */
+void closeReservationBook(ReservationBook *book)
+{
+    if (book == NULL)
+    {
+        return;
+    }
+
+    if (book->log_fd >= 0)
+    {
+        syncReservationLog(book);
+        close(book->log_fd);
+    }
+    for (int i = 0; i < book->room_count; i++)
+    {
+        free(book->rooms[i]);
+    }
+    pthread_mutex_destroy(&book->sync_lock);
+    pthread_cond_destroy(&book->sync_done);
+    free(book);
+}
@@ -0,0 +1,89 @@
+#ifndef ROOM_RESERVATION_H
+#define ROOM_RESERVATION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#define MAX_RESERVABLE_ROOMS 64 // One bit per room in an occupancy word
+#define TOTAL_SLOTS 5
+#define TOTAL_WEEKDAYS 5
+#define MAX_TERM_DAYS 140     // 20 weeks starting from the term start date
+#define LOG_RECORD_SIZE 100   // Longest reservation log line
+#define TERM_DATE_SIZE 11     // "YYYY-MM-DD" and the terminator
+
+// Result codes returned by reserveRoom and releaseRoom
+#define RESERVE_OK 0
+#define RESERVE_TAKEN 1
+#define RESERVE_INVALID 2
+#define RESERVE_NOT_HOLDER 3
+#define RESERVE_LOG_FAILED 4
+
+typedef struct ReservationBook
+{
+    char *rooms[MAX_RESERVABLE_ROOMS];
+    int room_count;
+    time_t term_start;
+    // Dates of the term days, computed once so lookups never call localtime
+    char term_dates[MAX_TERM_DAYS][TERM_DATE_SIZE];
+    int term_weekdays[MAX_TERM_DAYS]; // tm_wday (0 = Sunday)
+
+    // Bit r of occupancy[day][slot] is set when room r is taken by a class or a hold
+    _Atomic uint64_t occupancy[MAX_TERM_DAYS][TOTAL_SLOTS];
+    // User id holding room r, or 0 when the room is free or taken by a class
+    _Atomic int holders[MAX_TERM_DAYS][TOTAL_SLOTS][MAX_RESERVABLE_ROOMS];
+
+    // Group commit: records are appended without a lock and every caller waits
+    // for the first fsync that starts after its record was written
+    int log_fd; // -1 when holds are kept in memory only
+    _Atomic long appended_records;
+    long synced_records;
+    bool log_syncing;
+    _Atomic bool log_failed; // Set after a write or sync error, no record is written after it
+    pthread_mutex_t sync_lock;
+    pthread_cond_t sync_done;
+} ReservationBook;
+
+// Get index (0-4) of a time slot string, or -1 if unknown
+int getSlotIndex(char *time_slot);
+
+// Get time slot string of a slot index, or NULL if out of range
+char *getSlotName(int slot);
+
+// Get index (0-4) of a weekday name (Monday-Friday), or -1 if unknown
+int getWeekdayIndex(char *day);
+
+// Read trimmed room numbers from a file, returns the number read or -1 on errors
+int readRoomNames(char *rooms_file, char **rooms, int max_rooms);
+
+// Get index of a room in a list of room numbers, or -1 if unknown
+int findRoomIndex(char **rooms, int room_count, char *room);
+
+// Get index of a room in the book, or -1 if unknown
+int getRoomIndex(ReservationBook *book, char *room);
+
+// Write the date of a term day into date, returns its tm_wday (0 = Sunday)
+int getTermDate(ReservationBook *book, int term_day, char *date, int date_size);
+
+// Build occupancy from the timetable and replay the reservation log
+ReservationBook *openReservationBook(char *timetable_file, char *rooms_file, char *term_start_date, char *log_file);
+
+// Reserve a room for a date (YYYY-MM-DD) and time slot
+int reserveRoom(ReservationBook *book, int user_id, char *room, char *date, char *time_slot);
+
+// Release a room previously reserved by the same user
+int releaseRoom(ReservationBook *book, int user_id, char *room, char *date, char *time_slot);
+
+// Get list of "date,time slot,room" entries held by a user
+char **listReservations(ReservationBook *book, int user_id);
+
+// Wait until every log record written so far is on disk, returns false if a sync failed
+bool syncReservationLog(ReservationBook *book);
+
+// Sync the log and free the book
+void closeReservationBook(ReservationBook *book);
+
+#endif
@@ -0,0 +1,892 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "timetable_history.h"
+
+/* Function Declarations
+ * openTimetableHistory: Replays the versions stored in a history file
+ * loadTimetableVersion: Stores a timetable file as a delta against the newest version
+ * getTimeTableAt: getTimeTable for an earlier version
+ * checkFreeSlotsForDayAt: Free rooms for a day and time slot in an earlier version
+ *
+ * Every version is kept as a delta against the version before it, version 0
+ * against an empty timetable. Added and removed lines are sorted and front
+ * coded, so each line only stores the part that differs from the line before
+ * it, and changed occupancy words are stored as xor values. All numbers are
+ * variable length integers, and the same bytes are appended to the history
+ * file. Since removals name their lines, a section can be replayed on its own.
+ */
+
+//==============================================================================
+/**
+ * compareRecords - qsort comparison for arrays of timetable lines
+ */
+static int compareRecords(const void *first, const void *second)
+{
+    return strcmp(*(char *const *)first, *(char *const *)second);
+}
+
+//==============================================================================
+/**
+ * appendRecord - Appends a line pointer to a growing array
+ * @param records: Array to grow
+ * @param count: Number of lines in the array, updated
+ * @param capacity: Capacity of the array, updated
+ * @param record: Line to append
+ */
+static void appendRecord(char ***records, int *count, int *capacity, char *record)
+{
+    if (*count >= *capacity)
+    {
+        *capacity = *capacity == 0 ? 16 : *capacity * 2;
+        *records = realloc(*records, sizeof(char *) * (*capacity));
+        if (*records == NULL)
+        {
+            fprintf(stderr, "Memory allocation failed!\n");
+            exit(1);
+        }
+    }
+    (*records)[(*count)++] = record;
+}
+
+//==============================================================================
+/**
+ * freeRecords - Frees an array of timetable lines and the lines in it
+ */
+static void freeRecords(char **records, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        free(records[i]);
+    }
+    free(records);
+}
+
+//==============================================================================
+/**
+ * readTimetableRecords - Reads all timetable lines of a file in sorted order
+ * @param file_name: Path to timetable file
+ * @param count: Output number of lines read
+ * @return: Sorted array of line copies, or NULL if the file cannot be opened
+ *
+ * The header and malformed lines are skipped and line endings removed.
+ */
+static char **readTimetableRecords(char *file_name, int *count)
+{
+    FILE *timetable_file = fopen(file_name, "r");
+    if (timetable_file == NULL)
+    {
+        fprintf(stderr, "Error: Unable to open the file %s.\n", file_name);
+        return NULL;
+    }
+
+    char **records = NULL;
+    int capacity = 0;
+    *count = 0;
+    char timetable_line[TIMETABLE_LINE_SIZE];
+    while (fgets(timetable_line, sizeof(timetable_line), timetable_file))
+    {
+        timetable_line[strcspn(timetable_line, "\r\n")] = 0;
+        int entry_semester;
+        char entry_section;
+        if (sscanf(timetable_line, "%d,%c,", &entry_semester, &entry_section) != 2)
+        {
+            continue;
+        }
+
+        char *record = malloc(strlen(timetable_line) + 1);
+        strcpy(record, timetable_line);
+        appendRecord(&records, count, &capacity, record);
+    }
+    fclose(timetable_file);
+
+    // An empty timetable is still a valid version
+    if (records == NULL)
+    {
+        records = malloc(sizeof(char *));
+    }
+    qsort(records, *count, sizeof(char *), compareRecords);
+    return records;
+}
+
+//==============================================================================
+/**
+ * buildOccupancy - Computes the room bitmap of every (weekday, slot)
+ * @param history: Timetable history with the room list
+ * @param records: Timetable lines
+ * @param count: Number of lines
+ * @param occupancy: Output array of OCCUPANCY_WORDS words
+ */
+static void buildOccupancy(TimetableHistory *history, char **records, int count, uint64_t *occupancy)
+{
+    memset(occupancy, 0, sizeof(uint64_t) * OCCUPANCY_WORDS);
+    for (int i = 0; i < count; i++)
+    {
+        char entry_day[20], entry_time[20], room[20];
+        if (sscanf(records[i], "%*d,%*c,%19[^,],%19[^,],%*[^,],%*[^,],%19s", entry_day, entry_time, room) != 3)
+        {
+            continue;
+        }
+
+        int day = getWeekdayIndex(entry_day);
+        int slot = getSlotIndex(entry_time);
+        int room_index = findRoomIndex(history->rooms, history->room_count, room);
+        if (day >= 0 && slot >= 0 && room_index >= 0)
+        {
+            occupancy[day * TOTAL_SLOTS + slot] |= (uint64_t)1 << room_index;
+        }
+    }
+}
+
+//==============================================================================
+/**
+ * writeBytes - Appends bytes to a growing buffer
+ * @param buffer: Buffer to grow
+ * @param size: Bytes used in the buffer, updated
+ * @param capacity: Capacity of the buffer, updated
+ * @param data: Bytes to append
+ * @param length: Number of bytes to append
+ */
+static void writeBytes(unsigned char **buffer, int *size, int *capacity, const void *data, int length)
+{
+    if (length == 0)
+    {
+        return;
+    }
+    if (*size + length > *capacity)
+    {
+        while (*size + length > *capacity)
+        {
+            *capacity = *capacity == 0 ? 16 : *capacity * 2;
+        }
+        *buffer = realloc(*buffer, *capacity);
+        if (*buffer == NULL)
+        {
+            fprintf(stderr, "Memory allocation failed!\n");
+            exit(1);
+        }
+    }
+    memcpy(*buffer + *size, data, length);
+    *size += length;
+}
+
+//==============================================================================
+/**
+ * writeVarint - Appends an unsigned integer using 7 bits per byte
+ * @param buffer: Buffer to grow
+ * @param size: Bytes used in the buffer, updated
+ * @param capacity: Capacity of the buffer, updated
+ * @param value: Value to append
+ */
+static void writeVarint(unsigned char **buffer, int *size, int *capacity, uint64_t value)
+{
+    do
+    {
+        unsigned char byte = value & 0x7F;
+        value >>= 7;
+        byte |= value != 0 ? 0x80 : 0;
+        writeBytes(buffer, size, capacity, &byte, 1);
+    } while (value != 0);
+}
+
+//==============================================================================
+/**
+ * writeFrontCoded - Appends a line as the prefix length it shares with the line before it and the rest
+ * @param buffer: Buffer to grow
+ * @param size: Bytes used in the buffer, updated
+ * @param capacity: Capacity of the buffer, updated
+ * @param previous: Line written before this one, "" for the first line
+ * @param line: Line to append
+ */
+static void writeFrontCoded(unsigned char **buffer, int *size, int *capacity, char *previous, char *line)
+{
+    int shared = 0;
+    while (previous[shared] != 0 && previous[shared] == line[shared])
+    {
+        shared++;
+    }
+    int suffix = strlen(line) - shared;
+    writeVarint(buffer, size, capacity, shared);
+    writeVarint(buffer, size, capacity, suffix);
+    writeBytes(buffer, size, capacity, line + shared, suffix);
+}
+
+//==============================================================================
+/**
+ * readVarint - Reads an unsigned integer written by writeVarint
+ * @param buffer: Encoded bytes
+ * @param size: Number of encoded bytes
+ * @param position: Read position, advanced past the integer
+ * @param value: Output decoded value
+ * @return: 1 on success, 0 if the integer runs past the end of the buffer
+ */
+static int readVarint(unsigned char *buffer, int size, int *position, uint64_t *value)
+{
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (*position >= size)
+        {
+            return 0;
+        }
+        unsigned char byte = buffer[(*position)++];
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+//==============================================================================
+/**
+ * readBytes - Copies a length prefixed block of bytes out of a buffer
+ * @param buffer: Encoded bytes
+ * @param size: Number of encoded bytes
+ * @param position: Read position, advanced past the block
+ * @param block: Output copy of the block
+ * @param block_size: Output length of the block
+ * @return: 1 on success, 0 if the block runs past the end of the buffer
+ */
+static int readBytes(unsigned char *buffer, int size, int *position, unsigned char **block, int *block_size)
+{
+    uint64_t length;
+    if (!readVarint(buffer, size, position, &length) || length > (uint64_t)(size - *position))
+    {
+        return 0;
+    }
+    *block = malloc(length + 1);
+    memcpy(*block, buffer + *position, length);
+    *block_size = (int)length;
+    *position += (int)length;
+    return 1;
+}
+
+//==============================================================================
+/**
+ * freeDelta - Frees the encoded buffers of a delta
+ */
+static void freeDelta(TimetableDelta *delta)
+{
+    free(delta->added_lines);
+    free(delta->removed_lines);
+    free(delta->occupancy_changes);
+}
+
+//==============================================================================
+/**
+ * decodeLines - Expands front coded lines, keeping only those that start with a prefix
+ * @param encoded: Front coded lines
+ * @param encoded_size: Number of encoded bytes
+ * @param line_count: Number of encoded lines
+ * @param prefix: Prefix of the lines to keep, or NULL to keep every line
+ * @param match_count: Output number of lines kept
+ * @return: Array of line copies, or NULL if the encoding is damaged
+ *
+ * The lines are sorted, so decoding stops after the last line with the prefix.
+ */
+static char **decodeLines(unsigned char *encoded, int encoded_size, int line_count, char *prefix, int *match_count)
+{
+    char **lines = malloc(sizeof(char *) * (line_count + 1));
+    int prefix_length = prefix != NULL ? strlen(prefix) : 0;
+    char line[TIMETABLE_LINE_SIZE] = "";
+    uint64_t line_length = 0;
+    int position = 0;
+
+    *match_count = 0;
+    for (int i = 0; i < line_count; i++)
+    {
+        uint64_t shared, suffix;
+        if (!readVarint(encoded, encoded_size, &position, &shared) ||
+            !readVarint(encoded, encoded_size, &position, &suffix) ||
+            shared > line_length || suffix >= TIMETABLE_LINE_SIZE - shared ||
+            suffix > (uint64_t)(encoded_size - position))
+        {
+            freeRecords(lines, *match_count);
+            *match_count = 0;
+            return NULL;
+        }
+
+        // The new line keeps the first shared characters of the previous one
+        memcpy(line + shared, encoded + position, suffix);
+        position += (int)suffix;
+        line_length = shared + suffix;
+        line[line_length] = 0;
+
+        int order = prefix != NULL ? strncmp(line, prefix, prefix_length) : 0;
+        if (order > 0)
+        {
+            break;
+        }
+        if (order == 0)
+        {
+            lines[*match_count] = malloc(line_length + 1);
+            strcpy(lines[(*match_count)++], line);
+        }
+    }
+    return lines;
+}
+
+//==============================================================================
+/**
+ * applyDelta - Turns the sorted lines of one version into the next version
+ * @param delta: Timetable delta
+ * @param records: Sorted lines of the previous version, freed on success
+ * @param count: Number of lines, updated to the line count of the new version
+ * @param prefix: Only lines with this prefix are in records and are replayed, or NULL for all lines
+ * @return: Sorted lines of the new version, or NULL if the delta is damaged
+ *
+ * The records, the removed lines and the added lines are all sorted, so the
+ * removed lines are found and the new version is built in two merge passes.
+ */
+static char **applyDelta(TimetableDelta *delta, char **records, int *count, char *prefix)
+{
+    int removed_count, added_count;
+    char **removed = decodeLines(delta->removed_lines, delta->removed_size, delta->removed_count, prefix, &removed_count);
+    char **added = decodeLines(delta->added_lines, delta->added_size, delta->added_count, prefix, &added_count);
+
+    // Mark the removed lines, every one of them must be in the previous version
+    char *removed_flags = calloc(*count + 1, 1);
+    int k = 0;
+    for (int i = 0; removed != NULL && i < *count && k < removed_count; i++)
+    {
+        int order = strcmp(records[i], removed[k]);
+        if (order == 0)
+        {
+            removed_flags[i] = 1;
+            k++;
+        }
+        else if (order > 0)
+        {
+            break;
+        }
+    }
+    if (removed == NULL || added == NULL || k < removed_count)
+    {
+        free(removed_flags);
+        freeRecords(removed, removed_count);
+        freeRecords(added, added_count);
+        return NULL;
+    }
+
+    int merged_count = 0;
+    char **merged = malloc(sizeof(char *) * (*count - removed_count + added_count + 1));
+    int i = 0, j = 0;
+    while (i < *count || j < added_count)
+    {
+        if (i < *count && removed_flags[i])
+        {
+            free(records[i++]);
+        }
+        else if (j == added_count || (i < *count && strcmp(records[i], added[j]) <= 0))
+        {
+            merged[merged_count++] = records[i++];
+        }
+        else
+        {
+            merged[merged_count++] = added[j++];
+        }
+    }
+
+    free(removed_flags);
+    freeRecords(removed, removed_count);
+    free(added);
+    free(records);
+    *count = merged_count;
+    return merged;
+}
+
+//==============================================================================
+/**
+ * applyOccupancyChanges - Applies the xor changes of a delta to occupancy words
+ * @param delta: Timetable delta
+ * @param occupancy: Array of OCCUPANCY_WORDS words, updated
+ * @param target_word: Only this word is updated, or -1 for all words
+ * @return: 1 on success, 0 if the encoding is damaged
+ */
+static int applyOccupancyChanges(TimetableDelta *delta, uint64_t *occupancy, int target_word)
+{
+    int position = 0;
+    int64_t word = -1;
+    while (position < delta->occupancy_changes_size)
+    {
+        uint64_t gap, changed_bits;
+        if (!readVarint(delta->occupancy_changes, delta->occupancy_changes_size, &position, &gap) ||
+            !readVarint(delta->occupancy_changes, delta->occupancy_changes_size, &position, &changed_bits) ||
+            gap == 0 || gap > (uint64_t)(OCCUPANCY_WORDS - 1 - word))
+        {
+            return 0;
+        }
+        word += (int64_t)gap;
+        if (target_word < 0 || word == target_word)
+        {
+            occupancy[word] ^= changed_bits;
+        }
+    }
+    return 1;
+}
+
+//==============================================================================
+/**
+ * writeDelta - Appends one version to the history file
+ * @param file: History file, with nothing left in its stdio buffer
+ * @param delta: Timetable delta
+ * @return: 1 once the version is on disk, 0 on errors
+ *
+ * The bytes go straight to the file descriptor, so after an error no part
+ * of the version is left in a buffer to be written later.
+ */
+static int writeDelta(FILE *file, TimetableDelta *delta)
+{
+    unsigned char *record = NULL;
+    int size = 0, capacity = 0;
+    writeVarint(&record, &size, &capacity, delta->added_count);
+    writeVarint(&record, &size, &capacity, delta->added_size);
+    writeBytes(&record, &size, &capacity, delta->added_lines, delta->added_size);
+    writeVarint(&record, &size, &capacity, delta->removed_count);
+    writeVarint(&record, &size, &capacity, delta->removed_size);
+    writeBytes(&record, &size, &capacity, delta->removed_lines, delta->removed_size);
+    writeVarint(&record, &size, &capacity, delta->occupancy_changes_size);
+    writeBytes(&record, &size, &capacity, delta->occupancy_changes, delta->occupancy_changes_size);
+
+    int written = 0;
+    while (written < size)
+    {
+        ssize_t result = write(fileno(file), record + written, size - written);
+        if (result <= 0)
+        {
+            break;
+        }
+        written += result;
+    }
+    free(record);
+    return written == size && fsync(fileno(file)) == 0;
+}
+
+//==============================================================================
+/**
+ * readDelta - Reads one version written by writeDelta
+ * @param buffer: History file contents
+ * @param size: Size of the contents
+ * @param position: Read position, advanced past the version
+ * @param delta: Output delta
+ * @return: 1 on success, 0 if the version is cut short
+ */
+static int readDelta(unsigned char *buffer, int size, int *position, TimetableDelta *delta)
+{
+    uint64_t added_count, removed_count;
+    memset(delta, 0, sizeof(TimetableDelta));
+    if (readVarint(buffer, size, position, &added_count) && added_count <= (uint64_t)size &&
+        readBytes(buffer, size, position, &delta->added_lines, &delta->added_size) &&
+        readVarint(buffer, size, position, &removed_count) && removed_count <= (uint64_t)size &&
+        readBytes(buffer, size, position, &delta->removed_lines, &delta->removed_size) &&
+        readBytes(buffer, size, position, &delta->occupancy_changes, &delta->occupancy_changes_size))
+    {
+        delta->added_count = (int)added_count;
+        delta->removed_count = (int)removed_count;
+        return 1;
+    }
+    freeDelta(delta);
+    return 0;
+}
+
+//==============================================================================
+/**
+ * addVersion - Makes a delta the newest version of the history
+ * @param history: Timetable history
+ * @param delta: Delta against the current newest version
+ */
+static void addVersion(TimetableHistory *history, TimetableDelta *delta)
+{
+    history->deltas = realloc(history->deltas, sizeof(TimetableDelta) * (history->version_count + 1));
+    if (history->deltas == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed!\n");
+        exit(1);
+    }
+    history->deltas[history->version_count++] = *delta;
+}
+
+//==============================================================================
+/**
+ * readHistoryFile - Replays every version stored in a history file
+ * @param history: Empty timetable history
+ * @param buffer: History file contents
+ * @param size: Size of the contents
+ * @param damaged: Output 1 if a complete version could not be decoded
+ * @return: Number of bytes holding good versions, or -1 if this is not a history file
+ *
+ * The room list is stored in the file, since occupancy bits refer to its order.
+ */
+static int readHistoryFile(TimetableHistory *history, unsigned char *buffer, int size, int *damaged)
+{
+    *damaged = 0;
+    int position = strlen(HISTORY_MAGIC);
+    uint64_t room_count;
+    if (size < position || memcmp(buffer, HISTORY_MAGIC, position) != 0 ||
+        !readVarint(buffer, size, &position, &room_count) || room_count > MAX_RESERVABLE_ROOMS)
+    {
+        return -1;
+    }
+    for (uint64_t i = 0; i < room_count; i++)
+    {
+        unsigned char *room;
+        int length;
+        if (!readBytes(buffer, size, &position, &room, &length))
+        {
+            return -1;
+        }
+        room[length] = 0;
+        history->rooms[history->room_count++] = (char *)room;
+    }
+
+    // A version cut short by a crash, and anything after it, is dropped
+    while (position < size)
+    {
+        int version_start = position;
+        TimetableDelta delta;
+        if (!readDelta(buffer, size, &position, &delta))
+        {
+            return version_start;
+        }
+
+        // The newest version only changes once the whole delta decodes
+        uint64_t occupancy[OCCUPANCY_WORDS];
+        memcpy(occupancy, history->head_occupancy, sizeof(occupancy));
+        char **records = NULL;
+        if (applyOccupancyChanges(&delta, occupancy, -1))
+        {
+            records = applyDelta(&delta, history->head_records, &history->head_count, NULL);
+        }
+        if (records == NULL)
+        {
+            freeDelta(&delta);
+            *damaged = 1;
+            return version_start;
+        }
+        history->head_records = records;
+        memcpy(history->head_occupancy, occupancy, sizeof(occupancy));
+        addVersion(history, &delta);
+    }
+    return position;
+}
+
+//==============================================================================
+/**
+ * openTimetableHistory - Opens the stored versions of the timetable
+ * @param rooms_file: Path to file containing room numbers, used when the history is new
+ * @param history_file: Path to the history file, or NULL to keep versions in memory only
+ * @return: History with every stored version, or NULL on errors
+ *
+ * A damaged tail left by a crash while a version was written is cut off, so
+ * the next version is appended after the last complete one.
+ */
+TimetableHistory *openTimetableHistory(char *rooms_file, char *history_file)
+{
+    TimetableHistory *history = calloc(1, sizeof(TimetableHistory));
+    if (history == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed!\n");
+        return NULL;
+    }
+    history->head_records = malloc(sizeof(char *));
+
+    FILE *file = history_file != NULL ? fopen(history_file, "rb") : NULL;
+    if (file == NULL)
+    {
+        // New history: the room list comes from the rooms file and is written first
+        int room_count = readRoomNames(rooms_file, history->rooms, MAX_RESERVABLE_ROOMS);
+        if (room_count < 0)
+        {
+            closeTimetableHistory(history);
+            return NULL;
+        }
+        history->room_count = room_count;
+        if (history_file == NULL)
+        {
+            return history;
+        }
+
+        unsigned char *header = NULL;
+        int size = 0, capacity = 0;
+        writeBytes(&header, &size, &capacity, HISTORY_MAGIC, strlen(HISTORY_MAGIC));
+        writeVarint(&header, &size, &capacity, history->room_count);
+        for (int i = 0; i < history->room_count; i++)
+        {
+            writeVarint(&header, &size, &capacity, strlen(history->rooms[i]));
+            writeBytes(&header, &size, &capacity, history->rooms[i], strlen(history->rooms[i]));
+        }
+
+        history->history_file = fopen(history_file, "wb");
+        if (history->history_file == NULL || fwrite(header, 1, size, history->history_file) != (size_t)size ||
+            fflush(history->history_file) != 0)
+        {
+            fprintf(stderr, "Error: Unable to write the file %s.\n", history_file);
+            free(header);
+            closeTimetableHistory(history);
+            return NULL;
+        }
+        free(header);
+        return history;
+    }
+
+    // Existing history: replay every version in the file
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char *buffer = malloc(size + 1);
+    int read_ok = buffer != NULL && fread(buffer, 1, size, file) == (size_t)size;
+    fclose(file);
+
+    int damaged = 0;
+    int valid_size = read_ok ? readHistoryFile(history, buffer, (int)size, &damaged) : -1;
+    free(buffer);
+    if (valid_size < 0)
+    {
+        fprintf(stderr, "Error: %s is not a timetable history file.\n", history_file);
+        closeTimetableHistory(history);
+        return NULL;
+    }
+    if (damaged)
+    {
+        fprintf(stderr, "Warning: Damaged version in %s, keeping versions 0-%d.\n", history_file,
+                history->version_count - 1);
+    }
+    if (valid_size < size && truncate(history_file, valid_size) != 0)
+    {
+        fprintf(stderr, "Error: Unable to repair the file %s.\n", history_file);
+        closeTimetableHistory(history);
+        return NULL;
+    }
+
+    history->history_file = fopen(history_file, "ab");
+    if (history->history_file == NULL)
+    {
+        fprintf(stderr, "Error: Unable to open the file %s.\n", history_file);
+        closeTimetableHistory(history);
+        return NULL;
+    }
+    return history;
+}
+
+//==============================================================================
+/**
+ * loadTimetableVersion - Adds the contents of a timetable file as a new version
+ * @param history: Timetable history
+ * @param file_name: Path to timetable file
+ * @return: Number of the newest version, or -1 on errors
+ *
+ * The new lines are compared with the sorted lines of the newest version in
+ * one merge pass. When nothing changed no version is added, so loading the
+ * same file on every start does not grow the history. A version that cannot
+ * be saved is cut off the file again and not added.
+ */
+int loadTimetableVersion(TimetableHistory *history, char *file_name)
+{
+    int count;
+    char **records = readTimetableRecords(file_name, &count);
+    if (records == NULL)
+    {
+        return -1;
+    }
+
+    TimetableDelta delta = {0};
+    int added_capacity = 0, removed_capacity = 0, changes_capacity = 0;
+    char *previous_added = "";
+    char *previous_removed = "";
+
+    // Merge the sorted old and new lines
+    int i = 0, j = 0;
+    while (i < history->head_count || j < count)
+    {
+        int order;
+        if (i == history->head_count)
+        {
+            order = 1;
+        }
+        else if (j == count)
+        {
+            order = -1;
+        }
+        else
+        {
+            order = strcmp(history->head_records[i], records[j]);
+        }
+
+        if (order < 0)
+        {
+            writeFrontCoded(&delta.removed_lines, &delta.removed_size, &removed_capacity, previous_removed,
+                            history->head_records[i]);
+            delta.removed_count++;
+            previous_removed = history->head_records[i++];
+        }
+        else if (order > 0)
+        {
+            writeFrontCoded(&delta.added_lines, &delta.added_size, &added_capacity, previous_added, records[j]);
+            delta.added_count++;
+            previous_added = records[j++];
+        }
+        else
+        {
+            i++;
+            j++;
+        }
+    }
+
+    // Same lines as the newest version
+    if (history->version_count > 0 && delta.added_count == 0 && delta.removed_count == 0)
+    {
+        freeRecords(records, count);
+        return history->version_count - 1;
+    }
+
+    // Only the occupancy words that changed, as (index gap, xor) pairs
+    uint64_t occupancy[OCCUPANCY_WORDS];
+    buildOccupancy(history, records, count, occupancy);
+    int previous_word = -1;
+    for (int word = 0; word < OCCUPANCY_WORDS; word++)
+    {
+        uint64_t changed_bits = occupancy[word] ^ history->head_occupancy[word];
+        if (changed_bits != 0)
+        {
+            writeVarint(&delta.occupancy_changes, &delta.occupancy_changes_size, &changes_capacity, word - previous_word);
+            writeVarint(&delta.occupancy_changes, &delta.occupancy_changes_size, &changes_capacity, changed_bits);
+            previous_word = word;
+        }
+    }
+
+    if (history->history_file != NULL)
+    {
+        // Partial bytes would hide every later version, so a failed write is cut off again
+        int history_fd = fileno(history->history_file);
+        off_t previous_size = lseek(history_fd, 0, SEEK_END);
+        if (previous_size < 0 || !writeDelta(history->history_file, &delta))
+        {
+            fprintf(stderr, "Error: Unable to save timetable version %d.\n", history->version_count);
+            if (previous_size >= 0 && ftruncate(history_fd, previous_size) != 0)
+            {
+                fprintf(stderr, "Error: Unable to repair the timetable history file.\n");
+            }
+            freeDelta(&delta);
+            freeRecords(records, count);
+            return -1;
+        }
+    }
+    addVersion(history, &delta);
+
+    // The sorted new lines are the newest version from now on
+    freeRecords(history->head_records, history->head_count);
+    history->head_records = records;
+    history->head_count = count;
+    memcpy(history->head_occupancy, occupancy, sizeof(occupancy));
+    return history->version_count - 1;
+}
+
+//==============================================================================
+/**
+ * getTimeTableAt - Retrieves timetable entries of a semester and section in an earlier version
+ * @param history: Timetable history
+ * @param version: Version number returned by loadTimetableVersion
+ * @param semester: Target semester number
+ * @param section: Target section character
+ * @return: NULL terminated array of timetable lines, or NULL if the version does not exist
+ *
+ * Only the lines of the section are replayed from version 0 onwards, so the
+ * rest of the timetable is never built.
+ */
+char **getTimeTableAt(TimetableHistory *history, int version, int semester, char section)
+{
+    if (version < 0 || version >= history->version_count)
+    {
+        return NULL;
+    }
+
+    // Lines of a section start with "semester,section,"
+    char prefix[24];
+    snprintf(prefix, sizeof(prefix), "%d,%c,", semester, section);
+
+    // Deltas in memory were checked when they were created or read
+    int count = 0;
+    char **weekly_classes_array = malloc(sizeof(char *));
+    for (int v = 0; v <= version; v++)
+    {
+        weekly_classes_array = applyDelta(&history->deltas[v], weekly_classes_array, &count, prefix);
+    }
+    weekly_classes_array[count] = NULL;
+    return weekly_classes_array;
+}
+
+//==============================================================================
+/**
+ * checkFreeSlotsForDayAt - Lists free rooms for a day and time slot in an earlier version
+ * @param history: Timetable history
+ * @param version: Version number returned by loadTimetableVersion
+ * @param selected_day: Day name (Monday-Friday)
+ * @param selected_time_slot: Time slot string
+ * @return: NULL terminated array of free room numbers, or NULL on bad input
+ *
+ * Only the single occupancy word of the requested slot is rebuilt by applying
+ * the xor changes of every delta up to the version.
+ */
+char **checkFreeSlotsForDayAt(TimetableHistory *history, int version, char *selected_day, char *selected_time_slot)
+{
+    int day = getWeekdayIndex(selected_day);
+    int slot = getSlotIndex(selected_time_slot);
+    if (version < 0 || version >= history->version_count || day < 0 || slot < 0)
+    {
+        return NULL;
+    }
+
+    int target_word = day * TOTAL_SLOTS + slot;
+    uint64_t occupancy[OCCUPANCY_WORDS] = {0};
+    for (int v = 0; v <= version; v++)
+    {
+        applyOccupancyChanges(&history->deltas[v], occupancy, target_word);
+    }
+
+    char **free_rooms = malloc(sizeof(char *) * (history->room_count + 1));
+    int count = 0;
+    for (int room_index = 0; room_index < history->room_count; room_index++)
+    {
+        if (!(occupancy[target_word] & ((uint64_t)1 << room_index)))
+        {
+            free_rooms[count] = malloc(strlen(history->rooms[room_index]) + 1);
+            strcpy(free_rooms[count], history->rooms[room_index]);
+            count++;
+        }
+    }
+    free_rooms[count] = NULL;
+    return free_rooms;
+}
+
+//==============================================================================
+/**
+ * closeTimetableHistory - Closes the history file and frees all versions
+ * @param history: Timetable history
+ */
+void closeTimetableHistory(TimetableHistory *history)
+{
+    if (history == NULL)
+    {
+        return;
+    }
+
+    if (history->history_file != NULL)
+    {
+        fclose(history->history_file);
+    }
+    for (int v = 0; v < history->version_count; v++)
+    {
+        freeDelta(&history->deltas[v]);
+    }
+    free(history->deltas);
+    freeRecords(history->head_records, history->head_count);
+    for (int i = 0; i < history->room_count; i++)
+    {
+        free(history->rooms[i]);
+    }
+    free(history);
+}
@@ -0,0 +1,55 @@
+#ifndef TIMETABLE_HISTORY_H
+#define TIMETABLE_HISTORY_H
+
+#include "room_reservation.h"
+
+#define OCCUPANCY_WORDS (TOTAL_WEEKDAYS * TOTAL_SLOTS) // One room bitmap per (weekday, slot)
+#define TIMETABLE_LINE_SIZE 100
+#define HISTORY_MAGIC "TTHIST2\n"
+
+// Changes between one timetable version and the one before it, all varint encoded
+typedef struct TimetableDelta
+{
+    unsigned char *added_lines; // Sorted new lines, front coded: shared prefix length, suffix length, suffix
+    int added_count;
+    int added_size;
+    unsigned char *removed_lines; // Sorted lines of the previous version that are gone, front coded the same way
+    int removed_count;
+    int removed_size;
+    unsigned char *occupancy_changes; // Pairs of (word index gap, xor of old and new word)
+    int occupancy_changes_size;
+} TimetableDelta;
+
+typedef struct TimetableHistory
+{
+    char *rooms[MAX_RESERVABLE_ROOMS];
+    int room_count;
+
+    // deltas[v] turns version v - 1 into version v, version 0 starts from an empty timetable
+    TimetableDelta *deltas;
+    int version_count;
+
+    // Sorted lines of the newest version, used to diff the next load
+    char **head_records;
+    int head_count;
+    uint64_t head_occupancy[OCCUPANCY_WORDS];
+
+    FILE *history_file; // Every new version is appended here, NULL to keep versions in memory only
+} TimetableHistory;
+
+// Open a history file and replay its versions, or start a new history for the rooms in rooms_file
+TimetableHistory *openTimetableHistory(char *rooms_file, char *history_file);
+
+// Load a timetable file, stored as a new version only if its lines changed, returns the newest version or -1 on errors
+int loadTimetableVersion(TimetableHistory *history, char *file_name);
+
+// Get timetable for specific semester and section as it was in an earlier version
+char **getTimeTableAt(TimetableHistory *history, int version, int semester, char section);
+
+// Get list of free rooms for a day and time slot as it was in an earlier version
+char **checkFreeSlotsForDayAt(TimetableHistory *history, int version, char *selected_day, char *selected_time_slot);
+
+// Close the history file and free all versions
+void closeTimetableHistory(TimetableHistory *history);
+
+#endif